@@ -0,0 +1,98 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "benchmark.hpp"
+
+#include <animray/animation/animate.hpp>
+#include <animray/animation/procedural/rotate.hpp>
+#include <animray/cli/main.hpp>
+#include <animray/mixins/frame.hpp>
+#include <animray/ray.hpp>
+
+#include <random>
+#include <thread>
+
+
+/**
+ * Looks up a rotating position once per ray from several threads at once,
+ * both through `animate`, which caches the position per frame, and by
+ * calling the animation directly. The rays of a `stacatto_movie` are on
+ * two overlapping whole frames, and those of a `movie` have jittered frame
+ * times. Use `-t` to set the number of threads and `-n` the number of
+ * rays each looks up.
+ */
+
+
+int main(int argc, char const *const argv[]) {
+    auto const args = animray::cli::arguments{argc, argv, "", 0, 0};
+    std::size_t const repeats = args.switch_value('r', 5);
+    std::size_t const rays = args.switch_value('n', 2000000);
+    std::size_t const threads = std::max(
+            args.switch_value('t', std::thread::hardware_concurrency()), 1u);
+
+    using rotation = animray::animation::rotate_xy<animray::point3d<double>>;
+    using frame_ray =
+            animray::with_frame<animray::ray<double>, double>::type;
+    rotation const direct{animray::point3d<double>(1, 2, 3), 4, 0.1, 0.5};
+    animray::animate<rotation> const cached{direct};
+
+    /// The frame times for each thread. The stacatto threads alternate
+    /// between two frames as they would whilst one finishes and the next
+    /// starts
+    std::vector<std::vector<double>> stacatto(threads), movie(threads);
+    std::mt19937 generator;
+    std::uniform_real_distribution<double> jitter(0, 1);
+    for (std::size_t thread{}; thread != threads; ++thread) {
+        for (std::size_t ray{}; ray != rays; ++ray) {
+            stacatto[thread].push_back(double(7 + (ray / 64 + thread) % 2));
+            movie[thread].push_back(7 + jitter(generator));
+        }
+    }
+
+    double sum{};
+    auto const run = [&](auto const &frames, auto const &position) {
+        return animray::benchmark::best_of(repeats, [&]() {
+            std::vector<double> sums(threads);
+            std::vector<std::thread> running;
+            for (std::size_t thread{}; thread != threads; ++thread) {
+                running.emplace_back([&, thread]() {
+                    frame_ray ray;
+                    double s{};
+                    for (auto const f : frames[thread]) {
+                        ray.frame = f;
+                        auto const p = position(ray);
+                        s += p.x() + p.y() + p.z();
+                    }
+                    sums[thread] = s;
+                });
+            }
+            for (auto &thread : running) { thread.join(); }
+            for (auto const s : sums) { sum += s; }
+        });
+    };
+    auto const uncached = [&direct](frame_ray const &ray) {
+        return direct(ray.frame);
+    };
+    animray::benchmark::report(
+            "stacatto_movie", "direct", run(stacatto, uncached), "animate",
+            run(stacatto, cached));
+    animray::benchmark::report(
+            "movie", "direct", run(movie, uncached), "animate",
+            run(movie, cached));
+    return sum == 0;
+}
@@ -0,0 +1,63 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+
+
+namespace animray::benchmark {
+
+
+    /// Run the function `repeats` times and return the best wall clock time
+    /// in seconds
+    template<typename F>
+    double best_of(std::size_t const repeats, F fn) {
+        double best{};
+        for (std::size_t run{}; run != repeats; ++run) {
+            auto const started = std::chrono::steady_clock::now();
+            fn();
+            std::chrono::duration<double> const taken =
+                    std::chrono::steady_clock::now() - started;
+            if (run == 0 or taken.count() < best) { best = taken.count(); }
+        }
+        return best;
+    }
+
+
+    /// Print the time taken by a candidate compared to a baseline
+    inline void report(
+            std::string_view const name,
+            std::string_view const baseline_name,
+            double const baseline,
+            std::string_view const candidate_name,
+            double const candidate) {
+        std::cout << std::fixed << std::setprecision(4) << name << ": "
+                  << baseline_name << ' ' << baseline << "s, "
+                  << candidate_name << ' ' << candidate << "s, speed up x"
+                  << std::setprecision(2) << baseline / candidate << '\n';
+    }
+
+
+}
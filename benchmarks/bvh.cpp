@@ -0,0 +1,280 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "benchmark.hpp"
+#include "cube.hpp"
+
+#include <animray/affine.hpp>
+#include <animray/camera/pinhole.hpp>
+#include <animray/cli/main.hpp>
+#include <animray/color/hsl.hpp>
+#include <animray/color/srgb.hpp>
+#include <animray/compound.hpp>
+#include <animray/film.hpp>
+#include <animray/geometry/bvh-collection.hpp>
+#include <animray/geometry/collection.hpp>
+#include <animray/geometry/planar/triangle.hpp>
+#include <animray/geometry/quadrics/sphere-unit-origin.hpp>
+#include <animray/library/lights/block.hpp>
+#include <animray/light/ambient.hpp>
+#include <animray/light/collection.hpp>
+#include <animray/light/point.hpp>
+#include <animray/maths/angles.hpp>
+#include <animray/movable.hpp>
+#include <animray/scene.hpp>
+#include <animray/surface/gloss.hpp>
+#include <animray/surface/matte.hpp>
+#include <animray/surface/reflective.hpp>
+
+#include <random>
+
+
+/**
+ * Compares the linear scan `collection` against `bvh_collection` on the
+ * geometry from the `cube` and `spheres` scenes. The cube faces can be
+ * tessellated (`-n`) and the sphere count raised (`-c`) to see how each
+ * scales. Both images are rendered single threaded without jitter so that
+ * they can be checked for being identical.
+ */
+
+
+namespace {
+
+
+    using film_type = animray::film<animray::rgb<std::uint8_t>>;
+
+
+    template<typename S, typename C>
+    film_type render(
+            S const &scene,
+            C const &camera,
+            animray::cli::arguments const &args,
+            std::size_t const samples) {
+        return film_type{
+                args.width, args.height,
+                [&](film_type::size_type const x,
+                    film_type::size_type const y) {
+                    animray::rgb<float> photons;
+                    for (std::size_t sample{}; sample != samples; ++sample) {
+                        photons += scene(camera, x, y) /= samples;
+                    }
+                    return animray::to_srgb(photons, 1.4f * 255);
+                }};
+    }
+
+
+    template<typename S, typename C>
+    void compare(
+            std::string_view const name,
+            animray::cli::arguments const &args,
+            std::size_t const repeats,
+            std::size_t const samples,
+            C const &camera,
+            S const &linear,
+            auto const &bvh) {
+        film_type linear_image, bvh_image;
+        auto const linear_time = animray::benchmark::best_of(repeats, [&]() {
+            linear_image = render(linear, camera, args, samples);
+        });
+        auto const bvh_time = animray::benchmark::best_of(repeats, [&]() {
+            bvh_image = render(bvh, camera, args, samples);
+        });
+        animray::benchmark::report(
+                name, "linear", linear_time, "bvh", bvh_time);
+        std::size_t differences{};
+        for (std::size_t x{}; x < args.width; ++x) {
+            for (std::size_t y{}; y < args.height; ++y) {
+                if (linear_image[x][y] != bvh_image[x][y]) { ++differences; }
+            }
+        }
+        if (differences) {
+            std::cout << "  " << differences << " pixels differ\n";
+        }
+    }
+
+
+    void cube(animray::cli::arguments const &args, std::size_t const repeats) {
+        using world = float;
+        std::size_t const samples = args.switch_value('s', 2);
+        std::size_t const n = args.switch_value('n', 1);
+
+        world const aspect = world(args.width) / args.height;
+        bool const high = (args.height > args.width);
+        world const fw = high ? aspect * 0.036 : 0.036;
+        world const fh = high ? 0.036 : 0.036 / aspect;
+
+        auto const triangles = animray::benchmark::cube_triangles<world>(n);
+        using triangle = typename decltype(triangles)::value_type;
+        auto const linear = animray::scene{
+                animray::collection<triangle>{
+                        std::vector<triangle>{triangles}},
+                animray::library::lights::narrow_block<world>,
+                animray::rgb<float>{5, 18, 25}};
+        auto const bvh = animray::scene{
+                animray::bvh_collection<triangle>{
+                        std::vector<triangle>{triangles}},
+                animray::library::lights::narrow_block<world>,
+                animray::rgb<float>{5, 18, 25}};
+
+        animray::movable<
+                animray::pinhole_camera<animray::ray<world>>,
+                animray::ray<world>>
+                camera(fw, fh, args.width, args.height, 0.05);
+        camera(animray::rotate_x<world>(30_deg));
+        camera(animray::rotate_y<world>(60_deg));
+        camera(animray::translate<world>(0.0, 0.0, -6));
+
+        std::cout << "cube with " << triangles.size() << " triangles\n";
+        compare("cube", args, repeats, samples, camera, linear, bvh);
+    }
+
+
+    template<template<typename...> typename Collection>
+    auto spheres_scene(std::size_t const spheres) {
+        using world = double;
+        using gloss_sphere_type = animray::movable<animray::surface<
+                animray::unit_sphere_at_origin<animray::ray<world>>,
+                animray::gloss<world>, animray::matte<animray::rgb<float>>>>;
+        using reflective_sphere_type = animray::movable<animray::surface<
+                animray::unit_sphere_at_origin<animray::ray<world>>,
+                animray::reflective<float>,
+                animray::matte<animray::rgb<float>>>>;
+        using metallic_sphere_type = animray::movable<animray::surface<
+                animray::unit_sphere_at_origin<animray::ray<world>>,
+                animray::reflective<animray::rgb<float>>>>;
+        using scene_type = animray::scene<
+                animray::compound<
+                        reflective_sphere_type,
+                        Collection<metallic_sphere_type>,
+                        Collection<gloss_sphere_type>>,
+                animray::light<
+                        std::tuple<
+                                animray::light<void, float>,
+                                animray::light<
+                                        std::vector<animray::light<
+                                                animray::point3d<world>,
+                                                animray::rgb<float>>>,
+                                        animray::rgb<float>>>,
+                        animray::rgb<float>>,
+                animray::rgb<float>>;
+        scene_type scene;
+        scene.background = animray::rgb<float>(20, 70, 100);
+
+        const world scale(200.0);
+        std::get<0>(scene.geometry.instances) =
+                reflective_sphere_type{
+                        animray::unit_sphere_at_origin<animray::ray<world>>{},
+                        0.4f, animray::rgb<float>(0.3f)}(
+                        animray::translate<world>(0.0, 0.0, scale + 1.0))(
+                        animray::scale<world>(scale, scale, scale));
+
+        /// Keep the density of the original scene as the count goes up
+        world const spread = 20 * std::sqrt(spheres / world(10));
+        std::default_random_engine generator;
+        std::uniform_int_distribution<int> surface(1, 2);
+        std::uniform_real_distribution<world> hue(0, 360),
+                x_position(-spread, spread), y_position(-spread, spread);
+        for (std::size_t count{}; count != spheres; ++count) {
+            animray::hsl<float> hsl_colour(hue(generator), 1.0f, 0.5f);
+            auto colour(animray::convert_to<animray::rgb<float>>(hsl_colour));
+            auto location(animray::translate<world>(
+                    x_position(generator), y_position(generator), 0.0));
+            switch (surface(generator)) {
+            case 1:
+                std::get<1>(scene.geometry.instances)
+                        .insert(metallic_sphere_type{
+                                animray::unit_sphere_at_origin<
+                                        animray::ray<world>>{},
+                                colour}(location));
+                break;
+            case 2:
+            default:
+                std::get<2>(scene.geometry.instances)
+                        .insert(gloss_sphere_type{
+                                animray::unit_sphere_at_origin<
+                                        animray::ray<world>>{},
+                                10.0f, colour}(location));
+            }
+        }
+        if constexpr (requires {
+                          std::get<1>(scene.geometry.instances).build();
+                      }) {
+            std::get<1>(scene.geometry.instances).build();
+            std::get<2>(scene.geometry.instances).build();
+        }
+
+        std::get<0>(scene.light).color = 50;
+        for (auto const &bulb : animray::make_array(
+                     animray::point3d<world>(-5.0, 5.0, -5.0),
+                     animray::point3d<world>(-5.0, -5.0, -5.0),
+                     animray::point3d<world>(5.0, -5.0, -5.0))) {
+            std::get<1>(scene.light)
+                    .push_back(animray::light<
+                               animray::point3d<world>, animray::rgb<float>>(
+                            bulb, animray::rgb<float>(0x40, 0x80, 0x40)));
+        }
+        return scene;
+    }
+
+
+    template<typename O>
+    using linear_collection = animray::collection<O>;
+    template<typename O>
+    using bvh_collection = animray::bvh_collection<O>;
+
+
+    void
+            spheres(animray::cli::arguments const &args,
+                    std::size_t const repeats) {
+        using world = double;
+        std::size_t const samples = args.switch_value('s', 2);
+        std::size_t const count = args.switch_value('c', 10);
+
+        world const aspect = double(args.width) / args.height;
+        world const fw = args.width > args.height ? aspect * 0.024 : 0.024;
+        world const fh = args.width > args.height ? 0.024 : 0.024 / aspect;
+
+        auto const linear = spheres_scene<linear_collection>(count);
+        auto const bvh = spheres_scene<bvh_collection>(count);
+
+        animray::movable<
+                animray::pinhole_camera<animray::ray<world>>,
+                animray::ray<world>>
+                camera(fw, fh, args.width, args.height, 0.05);
+        camera(animray::rotate_x<world>(-65_deg))(
+                animray::translate<world>(0.0, -4.0, -40));
+
+        std::cout << "spheres with " << count << " spheres\n";
+        compare("spheres", args, repeats, samples, camera, linear, bvh);
+    }
+
+
+}
+
+
+int main(int argc, char const *const argv[]) {
+    auto const args = animray::cli::arguments{argc, argv, "", 96, 54};
+    std::size_t const repeats = args.switch_value('r', 3);
+
+    cube(args, repeats);
+    spheres(args, repeats);
+
+    return 0;
+}
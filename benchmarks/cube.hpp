@@ -0,0 +1,63 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+
+#include <animray/geometry/planar/triangle.hpp>
+#include <animray/ray.hpp>
+
+#include <vector>
+
+
+namespace animray::benchmark {
+
+
+    /// The triangles for a cube from -1 to 1 on each axis
+    template<
+            typename world,
+            typename triangle = animray::triangle<animray::ray<world>>>
+    auto cube_triangles(std::size_t const n) {
+        std::vector<triangle> triangles;
+        /// Each face is split into an `n` by `n` grid of quads
+        auto const face = [&](auto const corner) {
+            for (std::size_t i{}; i != n; ++i) {
+                for (std::size_t j{}; j != n; ++j) {
+                    auto const a = corner(i, j), b = corner(i + 1, j),
+                               c = corner(i + 1, j + 1), d = corner(i, j + 1);
+                    triangles.push_back(triangle{a, b, c});
+                    triangles.push_back(triangle{c, d, a});
+                }
+            }
+        };
+        auto const s = [n](std::size_t const i) {
+            return world(2) * i / n - world(1);
+        };
+        using p = typename triangle::corner_type;
+        face([&](auto i, auto j) { return p(s(i), s(j), 1); });
+        face([&](auto i, auto j) { return p(s(i), s(j), -1); });
+        face([&](auto i, auto j) { return p(s(i), 1, s(j)); });
+        face([&](auto i, auto j) { return p(s(i), -1, s(j)); });
+        face([&](auto i, auto j) { return p(1, s(i), s(j)); });
+        face([&](auto i, auto j) { return p(-1, s(i), s(j)); });
+        return triangles;
+    }
+
+
+}
@@ -0,0 +1,139 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "benchmark.hpp"
+
+#include <animray/cli/main.hpp>
+#include <animray/color/yuv.hpp>
+#include <animray/formats/exr.hpp>
+#include <animray/formats/pfm.hpp>
+#include <animray/formats/png.hpp>
+#include <animray/formats/qoi.hpp>
+#include <animray/formats/targa.hpp>
+#include <animray/formats/y4m.hpp>
+
+#include <sstream>
+
+
+/**
+ * Compares the size of a frame and the time taken to encode it as a raw
+ * Targa file, as PNG on one thread and on a `threading::pool`, and as QOI.
+ * The film is a shaded disc on a plain background, much like a rendered
+ * frame. Use `-t` to set the number of threads the pool has.
+ *
+ * The same frame as an `rgb<float>` film is then saved as PFM and as half
+ * float OpenEXR.
+ *
+ * Lastly a Y4M video frame is compared with converting each pixel through
+ * `yuv<float>` and averaging the chroma afterwards.
+ */
+
+
+int main(int argc, char const *const argv[]) {
+    auto const args = animray::cli::arguments{argc, argv, "", 1920, 1080};
+    std::size_t const repeats = args.switch_value('r', 5);
+    std::size_t const threads =
+            args.switch_value('t', std::thread::hardware_concurrency());
+    animray::threading::pool workers{threads};
+
+    auto const photons = [&](std::size_t x, std::size_t y) {
+        double const dx = double(x) - args.width / 2.0,
+                     dy = double(y) - args.height / 2.0, r = args.height / 3.0;
+        double const d2 = dx * dx + dy * dy;
+        if (d2 < r * r) {
+            float const shade = 255 * (1 - d2 / (r * r));
+            return animray::rgb<float>(shade, shade / 2, 40);
+        } else {
+            return animray::rgb<float>(5, 18, 25);
+        }
+    };
+    animray::film<animray::rgb<uint8_t>> const image{
+            args.width, args.height, [&](std::size_t x, std::size_t y) {
+                auto const p = photons(x, y);
+                return animray::rgb<uint8_t>(p.red(), p.green(), p.blue());
+            }};
+    animray::film<animray::rgb<float>> const hdr{
+            args.width, args.height, photons};
+    double const megabytes = image.width() * image.height() * 3 / 1e6;
+
+    std::size_t size{};
+    auto const time = [&](std::string_view const name, auto encode) {
+        double const seconds = animray::benchmark::best_of(
+                repeats, [&]() { size = encode().size(); });
+        std::cout << "  " << name << ' ' << megabytes / seconds << " MB/s, "
+                  << size << " bytes\n";
+        return seconds;
+    };
+    double const targa = time("targa", [&]() {
+        return animray::targa_bytes(image);
+    });
+    double const png = time("png", [&]() { return animray::png_bytes(image); });
+    double const pooled = time("png pool", [&]() {
+        return animray::png_bytes(image, &workers);
+    });
+    double const qoi = time("qoi", [&]() { return animray::qoi_bytes(image); });
+    animray::benchmark::report("encode", "png", png, "png pool", pooled);
+    animray::benchmark::report("encode", "targa", targa, "qoi", qoi);
+    double const pfm = time("pfm", [&]() { return animray::pfm_bytes(hdr); });
+    double const exr = time("exr", [&]() { return animray::exr_bytes(hdr); });
+    animray::benchmark::report("encode", "pfm", pfm, "exr", exr);
+
+    double const per_pixel = time("yuv<float>", [&]() {
+        std::size_t const w = image.width(), h = image.height();
+        std::vector<animray::yuv<float>> converted(w * h);
+        for (std::size_t y{}; y != h; ++y) {
+            for (std::size_t x{}; x != w; ++x) {
+                auto const &p = image.pixel(x, y);
+                converted[y * w + x] = animray::convert_to<animray::yuv<float>>(
+                        animray::rgb<float>(p.red(), p.green(), p.blue())
+                        * (1.0f / 255));
+            }
+        }
+        std::vector<std::uint8_t> planes(w * h + 2 * (w / 2) * (h / 2));
+        for (std::size_t i{}; i != w * h; ++i) {
+            planes[i] = 16 + 219 * converted[i].y();
+        }
+        std::uint8_t *const cb = planes.data() + w * h;
+        std::uint8_t *const cr = cb + (w / 2) * (h / 2);
+        for (std::size_t y{}; y != h / 2; ++y) {
+            for (std::size_t x{}; x != w / 2; ++x) {
+                float u{}, v{};
+                for (std::size_t i : {0u, 1u}) {
+                    for (std::size_t j : {0u, 1u}) {
+                        auto const &c = converted[(2 * y + j) * w + 2 * x + i];
+                        u += c.u() / 4;
+                        v += c.v() / 4;
+                    }
+                }
+                cb[y * (w / 2) + x] = 128 + 112 * u / 0.436f;
+                cr[y * (w / 2) + x] = 128 + 112 * v / 0.615f;
+            }
+        }
+        return planes;
+    });
+    double const y4m = time("y4m", [&]() {
+        std::ostringstream out;
+        animray::y4m_stream{out}.frame(image);
+        return out.str();
+    });
+    animray::benchmark::report(
+            "yuv 4:2:0", "yuv<float>", per_pixel, "y4m", y4m);
+    return 0;
+}
@@ -0,0 +1,153 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "benchmark.hpp"
+
+#include <animray/cli/main.hpp>
+#include <animray/film.hpp>
+#include <animray/mandelbrot.hpp>
+#include <animray/threading/sub-panel.hpp>
+
+
+/**
+ * Renders the same view of the Mandelbrot set a pixel at a time with
+ * `long double`, which is how `transformer` works as a film constructor,
+ * and then with `fill_lanes` in `long double`, `double` and `float`, with
+ * `fill`, and with `subdivide` on its own and in tiles with `sub_panel`. The
+ * number of pixels that differ from the first image is printed for each.
+ * Use `-x`, `-y` and `-d` to pick the view and `-b` for the number of bits
+ * of iteration count.
+ *
+ * After that the whole set, which is the default view of the mandelbrot
+ * scene, is rendered a pixel at a time with a plain loop that iterates the
+ * inside of the set all the way to the limit, and then with the
+ * transformer, which rejects the main bulbs and stops once an orbit cycles.
+ */
+
+
+int main(int argc, char const *const argv[]) {
+    auto const args = animray::cli::arguments{argc, argv, "", 640, 480};
+    std::size_t const repeats = args.switch_value('r', 3);
+    auto const centre_x = args.switch_value('x', -0.75L);
+    auto const centre_y = args.switch_value('y', 0.1L);
+    auto const diameter = args.switch_value('d', 0.5L);
+    std::size_t const bits = args.switch_value('b', 10);
+
+    using film_type = animray::film<std::uint16_t>;
+    animray::mandelbrot::transformer<film_type, long double> const mandelbrot{
+            args.width,
+            args.height,
+            centre_x,
+            centre_y,
+            diameter,
+            bits,
+            [](unsigned int d, std::size_t) { return std::uint16_t(d); }};
+
+    film_type expected{args.width, args.height, std::uint16_t{}};
+    double const per_pixel = animray::benchmark::best_of(repeats, [&]() {
+        expected = film_type{args.width, args.height, mandelbrot};
+    });
+
+    auto const lanes = [&](std::string_view const name, auto fill) {
+        film_type image{args.width, args.height, std::uint16_t{}};
+        double const seconds = animray::benchmark::best_of(
+                repeats, [&]() { fill(image); });
+        std::size_t differ{};
+        for (std::size_t y{}; y != args.height; ++y) {
+            for (std::size_t x{}; x != args.width; ++x) {
+                differ += (image.pixel(x, y) != expected.pixel(x, y));
+            }
+        }
+        animray::benchmark::report(
+                "mandelbrot", "per pixel", per_pixel, name, seconds);
+        std::cout << "  " << differ << " pixels differ\n";
+    };
+    lanes("long double x1", [&](film_type &image) {
+        mandelbrot.fill_lanes<long double, 1>(image);
+    });
+    lanes("double x4", [&](film_type &image) {
+        mandelbrot.fill_lanes<double, 4>(image);
+    });
+    lanes("float x8", [&](film_type &image) {
+        mandelbrot.fill_lanes<float, 8>(image);
+    });
+    lanes("fill", [&](film_type &image) { mandelbrot.fill(image); });
+    lanes("subdivide", [&](film_type &image) {
+        mandelbrot.subdivide(image.region(image.size()));
+    });
+    animray::threading::pool workers;
+    lanes("sub panel subdivide", [&](film_type &image) {
+        animray::threading::sub_panel_progress progress{
+                args.width, args.height, workers.size()};
+        image = workers.wait(animray::threading::sub_panel<film_type>(
+                workers, progress, args.width, args.height,
+                [&](film_type::region_view const &region) {
+                    mandelbrot.subdivide(region);
+                }));
+    });
+
+    animray::mandelbrot::transformer<film_type, long double> const whole{
+            args.width,
+            args.height,
+            0.0L,
+            0.0L,
+            2.0L,
+            8,
+            [](unsigned int d, std::size_t) { return std::uint16_t(d); }};
+    film_type plain{args.width, args.height, std::uint16_t{}};
+    double const every = animray::benchmark::best_of(repeats, [&]() {
+        plain = film_type{
+                args.width, args.height,
+                [&](std::size_t const lx, std::size_t const ly) {
+                    std::complex<long double> const position{
+                            (lx - args.width / 2.0L) * whole.per_pixel,
+                            (ly - args.height / 2.0L) * whole.per_pixel};
+                    unsigned int counter = 1;
+                    for (auto current = position;
+                         std::norm(current) < 4 and counter > 0;
+                         current = current * current + position) {
+                        counter = (counter + 1) & 255u;
+                    }
+                    return std::uint16_t(counter);
+                }};
+    });
+    film_type image{args.width, args.height, std::uint16_t{}};
+    double const shortcut = animray::benchmark::best_of(repeats, [&]() {
+        image = film_type{args.width, args.height, whole};
+    });
+    std::size_t differ{};
+    for (std::size_t y{}; y != args.height; ++y) {
+        for (std::size_t x{}; x != args.width; ++x) {
+            differ += (image.pixel(x, y) != plain.pixel(x, y));
+        }
+    }
+    animray::benchmark::report(
+            "whole set", "every iteration", every, "per pixel", shortcut);
+    std::cout << "  " << differ << " pixels differ\n";
+    double const filled = animray::benchmark::best_of(
+            repeats, [&]() { whole.fill(image); });
+    animray::benchmark::report(
+            "whole set", "every iteration", every, "fill", filled);
+    double const divided = animray::benchmark::best_of(
+            repeats, [&]() { whole.subdivide(image.region(image.size())); });
+    animray::benchmark::report(
+            "whole set", "every iteration", every, "subdivide", divided);
+    return 0;
+}
@@ -0,0 +1,181 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "benchmark.hpp"
+
+#include <animray/affine.hpp>
+#include <animray/camera/pinhole.hpp>
+#include <animray/cli/main.hpp>
+#include <animray/epsilon.hpp>
+#include <animray/geometry/collection.hpp>
+#include <animray/geometry/quadrics/sphere-unit-origin.hpp>
+#include <animray/maths/angles.hpp>
+#include <animray/movable.hpp>
+
+#include <algorithm>
+
+
+/**
+ * Compares `movable` instances that store their transforms as full 4x4
+ * `matrix` values against the default `affine_matrix`. A grid of scaled and
+ * rotated spheres is hit by the camera rays with `intersects` and with
+ * `occludes`, and both must agree on every ray. The camera is also timed
+ * as it is a `movable` too. Use `-n` to change the number of spheres along
+ * each side of the grid.
+ */
+
+
+namespace {
+
+
+    using world = float;
+    using ray_type = animray::ray<world>;
+    using sphere = animray::unit_sphere_at_origin<ray_type>;
+
+
+    template<typename M>
+    using moved = animray::
+            movable<sphere, ray_type, animray::transformable<M>>;
+
+
+    template<typename M>
+    auto grid(std::size_t const n) {
+        animray::collection<moved<M>> spheres;
+        for (std::size_t i{}; i < n; ++i) {
+            for (std::size_t j{}; j < n; ++j) {
+                world const x = world(4) * i / n - world(2),
+                            y = world(4) * j / n - world(2);
+                moved<M> s;
+                s(animray::scale<world>(world(1) / n, world(0.5) / n, 1));
+                s(animray::rotate_z<world>(world(i * 15) * 1_deg));
+                s(animray::translate<world>(x, y, 0));
+                spheres.insert(std::move(s));
+            }
+        }
+        return spheres;
+    }
+
+
+    template<typename M>
+    auto camera(animray::cli::arguments const &args) {
+        world const aspect = world(args.width) / args.height;
+        bool const high = (args.height > args.width);
+        world const fw = high ? aspect * 0.036 : 0.036;
+        world const fh = high ? 0.036 : 0.036 / aspect;
+        animray::movable<
+                animray::pinhole_camera<ray_type>, ray_type,
+                animray::transformable<M>>
+                c(fw, fh, args.width, args.height, 0.05);
+        c(animray::rotate_x<world>(10_deg));
+        c(animray::translate<world>(0.0, 0.0, -6));
+        return c;
+    }
+
+
+}
+
+
+int main(int argc, char const *const argv[]) {
+    auto const args = animray::cli::arguments{argc, argv, "", 384, 216};
+    std::size_t const repeats = args.switch_value('r', 5);
+    std::size_t const n = args.switch_value('n', 4);
+
+    using full = animray::matrix<world>;
+    using affine = animray::affine_matrix<world>;
+
+    auto const rays = [&](auto const &cam) {
+        std::vector<ray_type> result;
+        result.reserve(args.width * args.height);
+        for (std::size_t x{}; x < args.width; ++x) {
+            for (std::size_t y{}; y < args.height; ++y) {
+                result.push_back(ray_type{cam(x, y)});
+            }
+        }
+        return result;
+    };
+    std::vector<ray_type> full_rays, affine_rays;
+    animray::benchmark::report(
+            "camera", "matrix",
+            animray::benchmark::best_of(
+                    repeats,
+                    [&, cam = camera<full>(args)]() {
+                        full_rays = rays(cam);
+                    }),
+            "affine_matrix",
+            animray::benchmark::best_of(
+                    repeats, [&, cam = camera<affine>(args)]() {
+                        affine_rays = rays(cam);
+                    }));
+
+    auto const hits = [&](auto const &geometry) {
+        std::size_t count{};
+        for (auto const &r : affine_rays) {
+            if (geometry.intersects(r, animray::epsilon<world>)) { ++count; }
+        }
+        return count;
+    };
+    auto const occluded = [&](auto const &geometry) {
+        return std::count_if(
+                affine_rays.begin(), affine_rays.end(), [&](auto const &r) {
+                    return geometry.occludes(
+                            r, animray::epsilon<world>, world(5.5));
+                });
+    };
+
+    auto const full_spheres = grid<full>(n);
+    auto const affine_spheres = grid<affine>(n);
+    std::cout << full_spheres.instances.size() << " spheres and "
+              << affine_rays.size() << " camera rays\n";
+    std::size_t full_hits{}, affine_hits{}, full_occluded{},
+            affine_occluded{};
+    animray::benchmark::report(
+            "intersects", "matrix",
+            animray::benchmark::best_of(
+                    repeats, [&]() { full_hits = hits(full_spheres); }),
+            "affine_matrix",
+            animray::benchmark::best_of(
+                    repeats, [&]() { affine_hits = hits(affine_spheres); }));
+    animray::benchmark::report(
+            "occludes", "matrix",
+            animray::benchmark::best_of(
+                    repeats,
+                    [&]() { full_occluded = occluded(full_spheres); }),
+            "affine_matrix",
+            animray::benchmark::best_of(repeats, [&]() {
+                affine_occluded = occluded(affine_spheres);
+            }));
+
+    std::size_t differences{};
+    for (std::size_t index{}; index < full_rays.size(); ++index) {
+        if ((full_rays[index].from - affine_rays[index].from).magnitude()
+            > world(1e-4)) {
+            ++differences;
+        }
+    }
+    if (differences or full_hits != affine_hits
+        or full_occluded != affine_occluded) {
+        std::cout << "  " << differences << " camera rays differ, hits "
+                  << full_hits << " against " << affine_hits
+                  << ", occluded " << full_occluded << " against "
+                  << affine_occluded << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "benchmark.hpp"
+#include "cube.hpp"
+
+#include <animray/affine.hpp>
+#include <animray/camera/pinhole.hpp>
+#include <animray/cli/main.hpp>
+#include <animray/epsilon.hpp>
+#include <animray/geometry/collection.hpp>
+#include <animray/maths/angles.hpp>
+#include <animray/movable.hpp>
+
+#include <algorithm>
+
+
+/**
+ * Times the shadow rays for the `cube` scene. Every camera ray that
+ * strikes the cube casts a shadow ray towards each of the three bulbs in
+ * `narrow_block`. The shadow rays are tested with `occludes` and with
+ * `intersects` followed by a distance check, which is what `occludes` used
+ * to do, and both must agree on every ray. Use `-n` to tessellate the cube
+ * faces.
+ */
+
+
+namespace {
+
+
+    using world = float;
+    using ray_type = animray::ray<world>;
+
+
+    /// A shadow ray and the distance to the light
+    struct shadow {
+        ray_type by;
+        world distance;
+    };
+
+
+}
+
+
+int main(int argc, char const *const argv[]) {
+    auto const args = animray::cli::arguments{argc, argv, "", 384, 216};
+    std::size_t const repeats = args.switch_value('r', 5);
+    std::size_t const n = args.switch_value('n', 1);
+
+    world const aspect = world(args.width) / args.height;
+    bool const high = (args.height > args.width);
+    world const fw = high ? aspect * 0.036 : 0.036;
+    world const fh = high ? 0.036 : 0.036 / aspect;
+
+    auto const triangles = animray::benchmark::cube_triangles<world>(n);
+    using triangle = typename decltype(triangles)::value_type;
+    animray::collection<triangle> const cube{
+            std::vector<triangle>{triangles}};
+
+    animray::movable<animray::pinhole_camera<ray_type>, ray_type> camera(
+            fw, fh, args.width, args.height, 0.05);
+    camera(animray::rotate_x<world>(30_deg));
+    camera(animray::rotate_y<world>(60_deg));
+    camera(animray::translate<world>(0.0, 0.0, -6));
+
+    /// The bulbs from `narrow_spots`
+    auto const bulbs = animray::make_array(
+            animray::point3d<world>{-3.0, 5.0, -5.0},
+            animray::point3d<world>{-5.0, -3.0, -5.0},
+            animray::point3d<world>{3.0, -3.0, -5.0});
+
+    std::vector<shadow> shadows;
+    for (std::size_t x{}; x < args.width; ++x) {
+        for (std::size_t y{}; y < args.height; ++y) {
+            auto const hit = cube.intersects(
+                    ray_type{camera(x, y)}, animray::epsilon<world>);
+            if (not hit) { continue; }
+            for (auto const &bulb : bulbs) {
+                shadows.push_back(
+                        {ray_type{hit->from, bulb},
+                         (bulb - hit->from).magnitude()});
+            }
+        }
+    }
+
+    std::size_t by_intersection{}, by_occlusion{};
+    auto const intersects_time = animray::benchmark::best_of(repeats, [&]() {
+        by_intersection = std::count_if(
+                shadows.begin(), shadows.end(), [&](shadow const &s) {
+                    return std::any_of(
+                            cube.instances.begin(), cube.instances.end(),
+                            [&](triangle const &t) {
+                                auto const i = t.intersects(
+                                        s.by, animray::epsilon<world>);
+                                return i
+                                        and (i->from - s.by.from).magnitude()
+                                        < s.distance;
+                            });
+                });
+    });
+    auto const occludes_time = animray::benchmark::best_of(repeats, [&]() {
+        by_occlusion = std::count_if(
+                shadows.begin(), shadows.end(), [&](shadow const &s) {
+                    return cube.occludes(
+                            s.by, animray::epsilon<world>, s.distance);
+                });
+    });
+
+    std::cout << "cube with " << triangles.size() << " triangles and "
+              << shadows.size() << " shadow rays\n";
+    animray::benchmark::report(
+            "shadows", "intersects", intersects_time, "occludes",
+            occludes_time);
+    if (by_intersection != by_occlusion) {
+        std::cout << "  " << by_intersection << " occluded by intersection, "
+                  << by_occlusion << " by occlusion\n";
+        return 1;
+    }
+
+    return 0;
+}
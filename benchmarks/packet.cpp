@@ -0,0 +1,187 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "benchmark.hpp"
+#include "cube.hpp"
+
+#include <animray/affine.hpp>
+#include <animray/camera/pinhole.hpp>
+#include <animray/cli/main.hpp>
+#include <animray/color/srgb.hpp>
+#include <animray/film.hpp>
+#include <animray/geometry/collection.hpp>
+#include <animray/library/lights/block.hpp>
+#include <animray/maths/angles.hpp>
+#include <animray/movable.hpp>
+#include <animray/scene.hpp>
+
+
+/**
+ * Renders the `cube` scene one ray at a time and with packets of camera
+ * rays for blocks of 2x2 and 4x4 pixels. The images must be identical.
+ * The camera rays are also timed on their own, without any shading. Use
+ * `-n` to tessellate the cube faces.
+ */
+
+
+namespace {
+
+
+    using world = float;
+    using film_type = animray::film<animray::rgb<std::uint8_t>>;
+
+
+    template<typename S, typename C>
+    film_type render(
+            S const &scene,
+            C const &camera,
+            animray::cli::arguments const &args) {
+        return film_type{
+                args.width, args.height,
+                [&](film_type::size_type const x,
+                    film_type::size_type const y) {
+                    return animray::to_srgb(scene(camera, x, y), 1.4f * 255);
+                }};
+    }
+
+
+    template<std::size_t W, typename S, typename C>
+    film_type render_packets(
+            S const &scene,
+            C const &camera,
+            animray::cli::arguments const &args) {
+        std::vector<animray::rgb<float>> photons(args.width * args.height);
+        for (std::size_t y{}; y < args.height; y += W) {
+            for (std::size_t x{}; x < args.width; x += W) {
+                auto const colours = scene(camera.template packet<W>(x, y));
+                for (std::size_t row{}; row < W; ++row) {
+                    for (std::size_t column{}; column < W; ++column) {
+                        if (x + column < args.width
+                            and y + row < args.height) {
+                            photons[(y + row) * args.width + x + column] =
+                                    colours[row * W + column];
+                        }
+                    }
+                }
+            }
+        }
+        return film_type{
+                args.width, args.height,
+                [&](film_type::size_type const x,
+                    film_type::size_type const y) {
+                    return animray::to_srgb(
+                            photons[y * args.width + x], 1.4f * 255);
+                }};
+    }
+
+
+    std::size_t differences(film_type const &a, film_type const &b) {
+        std::size_t count{};
+        for (std::size_t x{}; x < a.width(); ++x) {
+            for (std::size_t y{}; y < a.height(); ++y) {
+                if (a[x][y] != b[x][y]) { ++count; }
+            }
+        }
+        return count;
+    }
+
+
+}
+
+
+int main(int argc, char const *const argv[]) {
+    auto const args = animray::cli::arguments{argc, argv, "", 384, 216};
+    std::size_t const repeats = args.switch_value('r', 5);
+    std::size_t const n = args.switch_value('n', 4);
+
+    world const aspect = world(args.width) / args.height;
+    bool const high = (args.height > args.width);
+    world const fw = high ? aspect * 0.036 : 0.036;
+    world const fh = high ? 0.036 : 0.036 / aspect;
+
+    auto const triangles = animray::benchmark::cube_triangles<world>(n);
+    using triangle = typename decltype(triangles)::value_type;
+    auto const scene = animray::scene{
+            animray::collection<triangle>{std::vector<triangle>{triangles}},
+            animray::library::lights::narrow_block<world>,
+            animray::rgb<float>{5, 18, 25}};
+
+    animray::movable<
+            animray::pinhole_camera<animray::ray<world>>, animray::ray<world>>
+            camera(fw, fh, args.width, args.height, 0.05);
+    camera(animray::rotate_x<world>(30_deg));
+    camera(animray::rotate_y<world>(60_deg));
+    camera(animray::translate<world>(0.0, 0.0, -6));
+
+    std::cout << "cube with " << triangles.size() << " triangles\n";
+    film_type single, two, four;
+    auto const single_time = animray::benchmark::best_of(
+            repeats, [&]() { single = render(scene, camera, args); });
+    auto const two_time = animray::benchmark::best_of(repeats, [&]() {
+        two = render_packets<2>(scene, camera, args);
+    });
+    auto const four_time = animray::benchmark::best_of(repeats, [&]() {
+        four = render_packets<4>(scene, camera, args);
+    });
+    animray::benchmark::report("cube", "single", single_time, "2x2", two_time);
+    animray::benchmark::report(
+            "cube", "single", single_time, "4x4", four_time);
+
+    std::size_t single_hits{}, packet_hits{};
+    auto const single_rays = animray::benchmark::best_of(repeats, [&]() {
+        single_hits = 0;
+        for (std::size_t y{}; y < args.height; ++y) {
+            for (std::size_t x{}; x < args.width; ++x) {
+                if (scene.geometry.intersects(
+                            camera(x, y), animray::epsilon<world>)) {
+                    ++single_hits;
+                }
+            }
+        }
+    });
+    auto const packet_rays = animray::benchmark::best_of(repeats, [&]() {
+        packet_hits = 0;
+        for (std::size_t y{}; y < args.height; y += 4) {
+            for (std::size_t x{}; x < args.width; x += 4) {
+                animray::packet_intersection<triangle::intersection_type, 16>
+                        closest;
+                scene.geometry.intersects(
+                        camera.packet<4>(x, y), animray::epsilon<world>,
+                        closest);
+                for (std::size_t lane{}; lane < 16; ++lane) {
+                    if (closest.hit[lane] and x + lane % 4 < args.width
+                        and y + lane / 4 < args.height) {
+                        ++packet_hits;
+                    }
+                }
+            }
+        }
+    });
+    animray::benchmark::report(
+            "camera rays", "single", single_rays, "4x4", packet_rays);
+
+    auto const differ = differences(single, two) + differences(single, four)
+            + (single_hits != packet_hits);
+    if (differ) {
+        std::cout << "  " << differ << " pixels differ\n";
+        return 1;
+    }
+    return 0;
+}
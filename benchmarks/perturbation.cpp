@@ -0,0 +1,158 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "benchmark.hpp"
+
+#include <animray/cli/main.hpp>
+#include <animray/film.hpp>
+#include <animray/mandelbrot/perturbation.hpp>
+
+
+/**
+ * Compares perturbation with working out every pixel directly. First at a
+ * zoom where `long double` still has enough precision, and then at a zoom
+ * where only a `fixed_point` does. Iterating every pixel with a
+ * `fixed_point` is slow, so the deep view is kept small. Last of all the
+ * full size deep view is rendered with and without the iterations that the
+ * series approximation skips. Use `-b` for the number of bits of iteration
+ * count and `-s` for the size of the small deep view.
+ */
+
+
+int main(int argc, char const *const argv[]) {
+    auto const args = animray::cli::arguments{argc, argv, "", 320, 240};
+    std::size_t const repeats = args.switch_value('r', 3);
+    std::size_t const bits = args.switch_value('b', 12);
+    std::size_t const size = args.switch_value('s', std::size_t{32});
+
+    using film_type = animray::film<std::uint16_t>;
+    using animray::fixed_point;
+    auto const counter = [](unsigned int d, std::size_t) {
+        return std::uint16_t(d);
+    };
+    auto const differences = [](film_type const &a, film_type const &b) {
+        std::size_t count{};
+        for (std::size_t y{}; y != a.height(); ++y) {
+            for (std::size_t x{}; x != a.width(); ++x) {
+                count += (a.pixel(x, y) != b.pixel(x, y));
+            }
+        }
+        return count;
+    };
+
+    {
+        char const *const x = "-0.743643887037151";
+        char const *const y = "0.13182590420533";
+        long double const diameter = 1e-13L;
+        animray::mandelbrot::transformer<film_type, long double> const direct{
+                args.width, args.height, std::stold(x), std::stold(y),
+                diameter,   bits,        counter};
+        film_type expected{args.width, args.height, std::uint16_t{}};
+        double const per_pixel = animray::benchmark::best_of(
+                repeats,
+                [&]() { direct.fill_lanes<long double, 1>(expected); });
+        film_type image{args.width, args.height, std::uint16_t{}};
+        double const perturbed = animray::benchmark::best_of(repeats, [&]() {
+            animray::mandelbrot::perturbation<film_type> const p{
+                    args.width,         args.height, fixed_point{x, 4},
+                    fixed_point{y, 4}, double(diameter), bits, counter};
+            p.fill(image);
+        });
+        animray::benchmark::report(
+                "mandelbrot 1e-13", "long double", per_pixel, "perturbation",
+                perturbed);
+        std::cout << "  " << differences(expected, image)
+                  << " pixels differ\n";
+    }
+
+    {
+        double const diameter = 1e-100;
+        std::size_t const limbs = fixed_point::limbs_for(
+                animray::mandelbrot::reference_bits(diameter / size));
+        fixed_point const x{0.0L, limbs}, y{1.0L, limbs};
+        std::size_t const limit = (std::size_t{1} << bits) - 1u;
+        film_type expected{size, size, std::uint16_t{}};
+        double const per_pixel = animray::benchmark::best_of(1, [&]() {
+            fixed_point const step{diameter / size, limbs};
+            for (std::size_t py{}; py != size; ++py) {
+                for (std::size_t px{}; px != size; ++px) {
+                    animray::mandelbrot::reference_orbit const orbit{
+                            x + fixed_point{double(px) - size / 2.0, limbs}
+                                    * step,
+                            y + fixed_point{double(py) - size / 2.0, limbs}
+                                    * step,
+                            limbs, limit};
+                    double const zx = orbit.x.back(), zy = orbit.y.back();
+                    std::size_t const count = zx * zx + zy * zy >= 4
+                            ? orbit.x.size() - 2
+                            : limit;
+                    expected.pixel(px, py) =
+                            std::uint16_t(count < limit ? count + 1 : 0);
+                }
+            }
+        });
+        film_type image{size, size, std::uint16_t{}};
+        double const perturbed = animray::benchmark::best_of(repeats, [&]() {
+            animray::mandelbrot::perturbation<film_type> const p{
+                    size, size, x, y, diameter, bits, counter};
+            p.fill(image);
+        });
+        animray::benchmark::report(
+                "mandelbrot 1e-100", "fixed point", per_pixel,
+                "perturbation", perturbed);
+        std::cout << "  " << differences(expected, image)
+                  << " pixels differ\n";
+    }
+    {
+        double const diameter = 1e-100;
+        std::size_t const limbs = fixed_point::limbs_for(
+                animray::mandelbrot::reference_bits(diameter / args.width));
+        animray::mandelbrot::perturbation<film_type> const p{
+                args.width,
+                args.height,
+                fixed_point{0.0L, limbs},
+                fixed_point{1.0L, limbs},
+                diameter,
+                bits,
+                counter};
+        film_type expected{args.width, args.height, std::uint16_t{}};
+        double const every = animray::benchmark::best_of(repeats, [&]() {
+            for (std::size_t py{}; py != args.height; ++py) {
+                for (std::size_t px{}; px != args.width; ++px) {
+                    std::size_t const count = p.orbit->escape_time(
+                            (double(px) - args.width / 2.0) * p.per_pixel,
+                            (double(py) - args.height / 2.0) * p.per_pixel,
+                            p.limit());
+                    expected.pixel(px, py) = std::uint16_t(
+                            count < p.limit() ? count + 1 : 0);
+                }
+            }
+        });
+        film_type image{args.width, args.height, std::uint16_t{}};
+        double const skipped = animray::benchmark::best_of(
+                repeats, [&]() { p.fill(image); });
+        animray::benchmark::report(
+                "perturbation 1e-100", "every iteration", every,
+                "series approximation", skipped);
+        std::cout << "  " << p.series.skip << " iterations skipped, "
+                  << differences(expected, image) << " pixels differ\n";
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "benchmark.hpp"
+
+#include <animray/cli/main.hpp>
+#include <animray/threading/sub-panel.hpp>
+
+#include <deque>
+
+
+/**
+ * Renders a short animation with the threads started for each frame, which
+ * waits for the slowest panel of every frame before the next can begin,
+ * and again with every frame queued on one persistent `threading::pool`.
+ * The pixels cost more towards one corner of the frame so some panels take
+ * much longer than others. Use `-f` to set the number of frames and `-t`
+ * the number of threads.
+ */
+
+
+namespace {
+
+
+    /// A pixel whose cost depends on where it is and on the frame
+    std::size_t pixel(
+            std::size_t const frame, std::size_t const x, std::size_t const y) {
+        std::size_t const iterations = 1 + (x * y) / 64;
+        std::size_t value = frame * 7919 + x * 31 + y;
+        for (std::size_t i{}; i != iterations; ++i) {
+            value = value * 6364136223846793005u + 1442695040888963407u;
+        }
+        return value;
+    }
+
+
+}
+
+
+int main(int argc, char const *const argv[]) {
+    auto const args = animray::cli::arguments{argc, argv, "", 384, 216};
+    std::size_t const repeats = args.switch_value('r', 5);
+    std::size_t const frames = args.switch_value('f', 12);
+    std::size_t const threads =
+            args.switch_value('t', std::thread::hardware_concurrency());
+    using film_type = animray::film<std::size_t>;
+
+    std::size_t per_frame_sum{}, pooled_sum{};
+    auto const checksum = [&](film_type const &image) {
+        std::size_t sum{};
+        image.for_each([&](std::size_t const p) { sum += p; });
+        return sum;
+    };
+
+    animray::threading::pool workers{threads};
+    animray::benchmark::report(
+            "animation", "threads per frame",
+            animray::benchmark::best_of(
+                    repeats,
+                    [&]() {
+                        per_frame_sum = 0;
+                        for (std::size_t frame{}; frame != frames; ++frame) {
+                            animray::threading::sub_panel_progress progress{
+                                    args.width, args.height, threads};
+                            per_frame_sum += checksum(
+                                    animray::threading::sub_panel<film_type>(
+                                            progress, threads, args.width,
+                                            args.height,
+                                            [frame](std::size_t x,
+                                                    std::size_t y) {
+                                                return pixel(frame, x, y);
+                                            }));
+                        }
+                    }),
+            "pool",
+            animray::benchmark::best_of(repeats, [&]() {
+                pooled_sum = 0;
+                std::deque<animray::threading::sub_panel_progress> progress;
+                std::vector<std::future<film_type>> rendered;
+                for (std::size_t frame{}; frame != frames; ++frame) {
+                    auto &p = progress.emplace_back(
+                            args.width, args.height, threads);
+                    rendered.push_back(animray::threading::sub_panel<film_type>(
+                            workers, p, args.width, args.height,
+                            [frame](std::size_t x, std::size_t y) {
+                                return pixel(frame, x, y);
+                            }));
+                }
+                for (auto &image : rendered) {
+                    pooled_sum += checksum(image.get());
+                }
+            }));
+
+    if (per_frame_sum != pooled_sum) {
+        std::cout << "  Checksums differ " << per_frame_sum << " against "
+                  << pooled_sum << '\n';
+        return 1;
+    }
+    return 0;
+}
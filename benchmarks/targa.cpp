@@ -0,0 +1,105 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "benchmark.hpp"
+
+#include <animray/cli/main.hpp>
+#include <animray/formats/targa.hpp>
+
+
+/**
+ * Compares writing a Targa file one byte at a time with `put`, which is
+ * how the files used to be written, against the buffered encoder, both raw
+ * and run length encoded. The film is a disc on a plain background, much
+ * like a rendered frame. Throughput is reported in MB/s of pixel data.
+ */
+
+
+namespace {
+
+
+    using film_type = animray::film<animray::rgb<uint8_t>>;
+
+
+    /// The old saver, a byte at a time
+    void put_each(std::filesystem::path const &filename, film_type const &f) {
+        std::ofstream file(filename, std::ios::binary);
+        for (int const b : {0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0}) {
+            file.put(char(b));
+        }
+        uint16_t const w(f.width()), h(f.height());
+        file.write(reinterpret_cast<const char *>(&w), 2);
+        file.write(reinterpret_cast<const char *>(&h), 2);
+        file.put(24);
+        file.put(0x20);
+        f.for_each_row([&file](animray::rgb<uint8_t> const &col) {
+            file.put(col.blue());
+            file.put(col.green());
+            file.put(col.red());
+        });
+        file.put(0);
+        file.put(0);
+        file << "TRUEVISION-XFILE.";
+        file.put(0);
+    }
+
+
+}
+
+
+int main(int argc, char const *const argv[]) {
+    auto const args = animray::cli::arguments{argc, argv, "", 1920, 1080};
+    std::size_t const repeats = args.switch_value('r', 5);
+    auto const filename =
+            std::filesystem::temp_directory_path() / "animray-benchmark.tga";
+
+    film_type const image{
+            args.width, args.height, [&](std::size_t x, std::size_t y) {
+                double const dx = double(x) - args.width / 2.0,
+                             dy = double(y) - args.height / 2.0;
+                if (dx * dx + dy * dy < args.height * args.height / 9.0) {
+                    return animray::rgb<uint8_t>(x % 256, y % 256, 128);
+                } else {
+                    return animray::rgb<uint8_t>(5, 18, 25);
+                }
+            }};
+    double const megabytes = image.width() * image.height() * 3 / 1e6;
+    auto const rate = [&](std::string_view const name, double const seconds) {
+        std::cout << "  " << name << ' ' << megabytes / seconds << " MB/s, "
+                  << std::filesystem::file_size(filename) << " bytes\n";
+        return seconds;
+    };
+
+    double const put = rate("put", animray::benchmark::best_of(repeats, [&]() {
+                                put_each(filename, image);
+                            }));
+    double const raw = rate("raw", animray::benchmark::best_of(repeats, [&]() {
+                                animray::targa(filename, image);
+                            }));
+    double const rle = rate("rle", animray::benchmark::best_of(repeats, [&]() {
+                                animray::targa(
+                                        filename, image,
+                                        animray::targa_encoding::rle);
+                            }));
+    animray::benchmark::report("targa", "put", put, "raw", raw);
+    animray::benchmark::report("targa", "put", put, "rle", rle);
+    std::filesystem::remove(filename);
+    return 0;
+}
@@ -0,0 +1,180 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "benchmark.hpp"
+#include "cube.hpp"
+
+#include <animray/affine.hpp>
+#include <animray/camera/pinhole.hpp>
+#include <animray/cli/main.hpp>
+#include <animray/epsilon.hpp>
+#include <animray/geometry/collection.hpp>
+#include <animray/geometry/planar/triangle-accelerated.hpp>
+#include <animray/geometry/planar/triangle-batch.hpp>
+#include <animray/maths/angles.hpp>
+#include <animray/movable.hpp>
+
+#include <algorithm>
+
+
+/**
+ * Compares `triangle` against `accelerated_triangle` and `triangle_batch`
+ * on the `cube` scene geometry. The camera rays are timed with
+ * `intersects` and the shadow rays towards the `narrow_block` bulbs with
+ * `occludes`. The triangles are held in a plain `collection`, or a single
+ * batch, so every ray is tested against every triangle, and all must give
+ * the same answers. Use `-n` to change how
+ * finely the cube faces are tessellated.
+ */
+
+
+namespace {
+
+
+    using world = float;
+    using ray_type = animray::ray<world>;
+
+
+    template<typename T>
+    auto cube(std::size_t const n) {
+        return animray::collection<T>{
+                animray::benchmark::cube_triangles<world, T>(n)};
+    }
+
+
+    template<std::size_t N>
+    auto batch(std::size_t const n) {
+        return animray::triangle_batch<ray_type, N>{
+                animray::benchmark::cube_triangles<world>(n)};
+    }
+
+
+}
+
+
+int main(int argc, char const *const argv[]) {
+    auto const args = animray::cli::arguments{argc, argv, "", 384, 216};
+    std::size_t const repeats = args.switch_value('r', 5);
+    std::size_t const n = args.switch_value('n', 4);
+
+    world const aspect = world(args.width) / args.height;
+    bool const high = (args.height > args.width);
+    world const fw = high ? aspect * 0.036 : 0.036;
+    world const fh = high ? 0.036 : 0.036 / aspect;
+
+    auto const plain = cube<animray::triangle<ray_type>>(n);
+
+    animray::movable<animray::pinhole_camera<ray_type>, ray_type> camera(
+            fw, fh, args.width, args.height, 0.05);
+    camera(animray::rotate_x<world>(30_deg));
+    camera(animray::rotate_y<world>(60_deg));
+    camera(animray::translate<world>(0.0, 0.0, -6));
+
+    std::vector<ray_type> primary;
+    for (std::size_t x{}; x < args.width; ++x) {
+        for (std::size_t y{}; y < args.height; ++y) {
+            primary.push_back(ray_type{camera(x, y)});
+        }
+    }
+
+    /// The bulbs from `narrow_spots`
+    auto const bulbs = animray::make_array(
+            animray::point3d<world>{-3.0, 5.0, -5.0},
+            animray::point3d<world>{-5.0, -3.0, -5.0},
+            animray::point3d<world>{3.0, -3.0, -5.0});
+    std::vector<std::pair<ray_type, world>> shadows;
+    for (auto const &r : primary) {
+        auto const hit = plain.intersects(r, animray::epsilon<world>);
+        if (not hit) { continue; }
+        for (auto const &bulb : bulbs) {
+            shadows.emplace_back(
+                    ray_type{hit->from, bulb}, (bulb - hit->from).magnitude());
+        }
+    }
+
+    auto const hits = [&](auto const &geometry) {
+        std::vector<std::optional<ray_type>> result;
+        result.reserve(primary.size());
+        for (auto const &r : primary) {
+            result.push_back(geometry.intersects(r, animray::epsilon<world>));
+        }
+        return result;
+    };
+    auto const occluded = [&](auto const &geometry) {
+        return std::count_if(
+                shadows.begin(), shadows.end(), [&](auto const &s) {
+                    return geometry.occludes(
+                            s.first, animray::epsilon<world>, s.second);
+                });
+    };
+
+    std::vector<std::optional<ray_type>> plain_hits;
+    std::size_t plain_occluded{};
+    auto const plain_intersects = animray::benchmark::best_of(
+            repeats, [&]() { plain_hits = hits(plain); });
+    auto const plain_occludes = animray::benchmark::best_of(
+            repeats, [&]() { plain_occluded = occluded(plain); });
+
+    std::cout << "cube with " << plain.instances.size() << " triangles, "
+              << primary.size() << " camera rays and " << shadows.size()
+              << " shadow rays\n";
+
+    /// Time the candidate against `triangle` and return true if the
+    /// results are the same
+    auto const compare = [&](std::string_view const name,
+                             auto const &geometry) {
+        std::vector<std::optional<ray_type>> candidate_hits;
+        std::size_t candidate_occluded{};
+        auto const intersects_time = animray::benchmark::best_of(
+                repeats, [&]() { candidate_hits = hits(geometry); });
+        auto const occludes_time = animray::benchmark::best_of(
+                repeats, [&]() { candidate_occluded = occluded(geometry); });
+        animray::benchmark::report(
+                "intersects", "triangle", plain_intersects, name,
+                intersects_time);
+        animray::benchmark::report(
+                "occludes", "triangle", plain_occludes, name, occludes_time);
+
+        std::size_t differences{};
+        for (std::size_t index{}; index < primary.size(); ++index) {
+            auto const &p = plain_hits[index];
+            auto const &c = candidate_hits[index];
+            if (p.has_value() != c.has_value()
+                or (p and (p->from - c->from).magnitude() > world(1e-4))) {
+                ++differences;
+            }
+        }
+        if (differences or plain_occluded != candidate_occluded) {
+            std::cout << "  " << differences << " camera rays differ, "
+                      << plain_occluded << " shadow rays occluded against "
+                      << candidate_occluded << '\n';
+            return false;
+        }
+        return true;
+    };
+
+    bool const same =
+            compare("accelerated",
+                    cube<animray::accelerated_triangle<ray_type>>(n))
+            and compare("batch of 4", batch<4>(n))
+            and compare("batch of 8", batch<8>(n));
+
+    return same ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "benchmark.hpp"
+#include "cube.hpp"
+
+#include <animray/affine.hpp>
+#include <animray/camera/pinhole.hpp>
+#include <animray/cli/main.hpp>
+#include <animray/epsilon.hpp>
+#include <animray/geometry/collection.hpp>
+#include <animray/geometry/quadrics/sphere-unit-origin.hpp>
+#include <animray/maths/angles.hpp>
+#include <animray/movable.hpp>
+
+#include <algorithm>
+
+
+/**
+ * Compares rays made from the homogeneous `point3d` and `unit_vector`
+ * against rays made from `vec3` and `unit_vec3`. The same camera rays are
+ * fired at the `cube` scene triangles and at a scaled and moved sphere,
+ * with `intersects` and with `occludes`, and both ray types must agree on
+ * what they hit. Use `-n` to change how finely the cube faces are
+ * tessellated.
+ */
+
+
+namespace {
+
+
+    using world = float;
+    using point_ray = animray::ray<world>;
+    using vec_ray = animray::
+            ray<world, animray::vec3<world>, animray::unit_vec3<world>>;
+
+
+    template<typename R>
+    auto cube(std::size_t const n) {
+        using triangle = animray::triangle<R>;
+        return animray::collection<triangle>{
+                animray::benchmark::cube_triangles<world, triangle>(n)};
+    }
+
+
+    template<typename R>
+    auto sphere() {
+        animray::movable<animray::unit_sphere_at_origin<R>> s;
+        s(animray::scale<world>(1.5, 1, 1));
+        s(animray::rotate_z<world>(30_deg));
+        s(animray::translate<world>(0.5, -0.25, 0));
+        return s;
+    }
+
+
+}
+
+
+int main(int argc, char const *const argv[]) {
+    auto const args = animray::cli::arguments{argc, argv, "", 384, 216};
+    std::size_t const repeats = args.switch_value('r', 5);
+    std::size_t const n = args.switch_value('n', 4);
+
+    world const aspect = world(args.width) / args.height;
+    bool const high = (args.height > args.width);
+    world const fw = high ? aspect * 0.036 : 0.036;
+    world const fh = high ? 0.036 : 0.036 / aspect;
+
+    animray::movable<animray::pinhole_camera<point_ray>, point_ray> camera(
+            fw, fh, args.width, args.height, 0.05);
+    camera(animray::rotate_x<world>(30_deg));
+    camera(animray::rotate_y<world>(60_deg));
+    camera(animray::translate<world>(0.0, 0.0, -6));
+
+    std::vector<point_ray> point_rays;
+    std::vector<vec_ray> vec_rays;
+    for (std::size_t x{}; x < args.width; ++x) {
+        for (std::size_t y{}; y < args.height; ++y) {
+            point_ray const r{camera(x, y)};
+            point_rays.push_back(r);
+            vec_rays.emplace_back(
+                    animray::vec3<world>{r.from},
+                    animray::unit_vec3<world>{r.direction});
+        }
+    }
+    std::cout << point_rays.size() << " camera rays\n";
+
+    /// Count the hits, and sum up where they are so that the two ray types
+    /// can be compared
+    auto const hits = [&](auto const &rays, auto const &geometry) {
+        std::pair<std::size_t, world> result{};
+        for (auto const &r : rays) {
+            if (auto const hit =
+                        geometry.intersects(r, animray::epsilon<world>)) {
+                ++result.first;
+                result.second += hit->from.x() + hit->from.y()
+                        + hit->from.z();
+            }
+        }
+        return result;
+    };
+    auto const occluded = [&](auto const &rays, auto const &geometry) {
+        return std::count_if(rays.begin(), rays.end(), [&](auto const &r) {
+            return geometry.occludes(r, animray::epsilon<world>, world(6));
+        });
+    };
+
+    /// Time the two ray types and return true if they found the same
+    /// things
+    auto const compare = [&](std::string_view const name,
+                             auto const &point_geometry,
+                             auto const &vec_geometry) {
+        std::pair<std::size_t, world> point_hits, vec_hits;
+        std::size_t point_occluded{}, vec_occluded{};
+        animray::benchmark::report(
+                name, "point3d intersects",
+                animray::benchmark::best_of(
+                        repeats,
+                        [&]() {
+                            point_hits = hits(point_rays, point_geometry);
+                        }),
+                "vec3",
+                animray::benchmark::best_of(repeats, [&]() {
+                    vec_hits = hits(vec_rays, vec_geometry);
+                }));
+        animray::benchmark::report(
+                name, "point3d occludes",
+                animray::benchmark::best_of(
+                        repeats,
+                        [&]() {
+                            point_occluded =
+                                    occluded(point_rays, point_geometry);
+                        }),
+                "vec3",
+                animray::benchmark::best_of(repeats, [&]() {
+                    vec_occluded = occluded(vec_rays, vec_geometry);
+                }));
+        bool const same = point_hits.first == vec_hits.first
+                and std::abs(point_hits.second - vec_hits.second)
+                        < world(1e-3) * point_hits.first
+                and point_occluded == vec_occluded;
+        if (not same) {
+            std::cout << "  " << name << " hits " << point_hits.first
+                      << " against " << vec_hits.first << ", occluded "
+                      << point_occluded << " against " << vec_occluded
+                      << '\n';
+        }
+        return same;
+    };
+
+    bool const same =
+            compare("cube", cube<point_ray>(n), cube<vec_ray>(n))
+            and compare("sphere", sphere<point_ray>(), sphere<vec_ray>());
+
+    return same ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_AFFINE_MATRIX_HPP
+#define ANIMRAY_AFFINE_MATRIX_HPP
+#pragma once
+
+
+#include <animray/matrix.hpp>
+#include <animray/vec3.hpp>
+
+
+namespace animray {
+
+
+    /**
+     * # Affine matrix
+     *
+     * An affine transformation never changes the bottom row of a 4x4
+     * matrix, which is always `0 0 0 1`, so only the top three rows are
+     * stored. Each row holds the three linear terms followed by the
+     * translation, which keeps a row the width of a four lane vector.
+     *
+     * Element access through `[row][column]` is not bounds checked. Points
+     * and directions are transformed separately: a direction only needs the
+     * linear part and is never translated. Neither needs a divide.
+     */
+    template<typename D>
+    class affine_matrix {
+      public:
+        using value_type = D;
+        /// The type of each row
+        using row_type = std::array<D, 4>;
+
+        /// Construct an identity transform matrix
+        constexpr affine_matrix() noexcept
+        : rows{{{D{1}, D{}, D{}, D{}},
+                {D{}, D{1}, D{}, D{}},
+                {D{}, D{}, D{1}, D{}}}} {}
+
+        /// Fetch a row so that values can be accessed as `m[row][column]`
+        constexpr row_type &operator[](std::size_t const r) noexcept {
+            return rows[r];
+        }
+        /// Fetch a row so that values can be accessed as `m[row][column]`
+        constexpr row_type const &
+                operator[](std::size_t const r) const noexcept {
+            return rows[r];
+        }
+
+        /// Convert to the equivalent full 4x4 matrix
+        operator matrix<D>() const {
+            matrix<D> m;
+            for (std::size_t r{}; r < 3; ++r) {
+                for (std::size_t c{}; c < 4; ++c) { m[r][c] = rows[r][c]; }
+            }
+            return m;
+        }
+
+        /// Compare for equality
+        constexpr bool operator==(affine_matrix const &) const = default;
+
+        /// Combine two transformations. The right hand one is applied first
+        constexpr affine_matrix operator*(affine_matrix const &r) const {
+            affine_matrix result;
+            for (std::size_t row{}; row < 3; ++row) {
+                for (std::size_t col{}; col < 4; ++col) {
+                    result.rows[row][col] = rows[row][0] * r.rows[0][col]
+                            + rows[row][1] * r.rows[1][col]
+                            + rows[row][2] * r.rows[2][col]
+                            + (col == 3 ? rows[row][3] : D{});
+                }
+            }
+            return result;
+        }
+        /// Combine with another transformation, which is applied first
+        constexpr affine_matrix &operator*=(affine_matrix const &r) {
+            return *this = *this * r;
+        }
+
+        /// Transform a location. The homogeneous `w` is carried through
+        point3d<D> operator*(point3d<D> const &p) const {
+            auto const &a = p.array();
+            return point3d<D>(
+                    linear(0, a[0], a[1], a[2]) + rows[0][3] * a[3],
+                    linear(1, a[0], a[1], a[2]) + rows[1][3] * a[3],
+                    linear(2, a[0], a[1], a[2]) + rows[2][3] * a[3], a[3]);
+        }
+        /// Transform a location
+        vec3<D> operator*(vec3<D> const &p) const {
+            return {linear(0, p.x(), p.y(), p.z()) + rows[0][3],
+                    linear(1, p.x(), p.y(), p.z()) + rows[1][3],
+                    linear(2, p.x(), p.y(), p.z()) + rows[2][3]};
+        }
+
+        /// Transform a direction, which ignores the translation. The result
+        /// is not normalised
+        point3d<D> direction(point3d<D> const &v) const {
+            auto const &a = v.array();
+            return point3d<D>(
+                    linear(0, a[0], a[1], a[2]), linear(1, a[0], a[1], a[2]),
+                    linear(2, a[0], a[1], a[2]), a[3]);
+        }
+        /// Transform a direction, which ignores the translation. The result
+        /// is not normalised
+        point3d<D> direction(unit_vector<D> const &v) const {
+            return direction(point3d<D>{v});
+        }
+        /// Transform a direction, which ignores the translation. The result
+        /// is not normalised
+        vec3<D> direction(vec3<D> const &v) const {
+            return {linear(0, v.x(), v.y(), v.z()),
+                    linear(1, v.x(), v.y(), v.z()),
+                    linear(2, v.x(), v.y(), v.z())};
+        }
+
+        /// Print each row as `(a, b, c, d)` on its own line
+        std::ostream &print_on(std::ostream &o) const {
+            for (auto const &row : rows) {
+                o << "(";
+                for (std::size_t c{}; c < row.size(); ++c) {
+                    if (c != 0) o << ", ";
+                    o << row[c];
+                }
+                o << ")\n";
+            }
+            return o;
+        }
+
+      private:
+        alignas(16) std::array<row_type, 3> rows;
+
+        /// The linear part of a row applied to a vector
+        constexpr D linear(
+                std::size_t const r, D const x, D const y, D const z) const {
+            return rows[r][0] * x + rows[r][1] * y + rows[r][2] * z;
+        }
+    };
+
+
+    /// Output to a stream
+    template<typename D>
+    std::ostream &operator<<(std::ostream &o, affine_matrix<D> const &m) {
+        return m.print_on(o);
+    }
+
+
+}
+
+
+#endif // ANIMRAY_AFFINE_MATRIX_HPP
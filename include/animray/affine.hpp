@@ -24,7 +24,7 @@
 #pragma once
 
 
-#include <animray/matrix.hpp>
+#include <animray/affine-matrix.hpp>
 
 
 namespace animray {
@@ -43,8 +43,8 @@ namespace animray {
         point3d<W> operator()() const { return point3d<W>(x, y, z); }
 
         /// Return the forward matrix for the translation
-        matrix<W> forward() const {
-            matrix<W> f;
+        affine_matrix<W> forward() const {
+            affine_matrix<W> f;
             f[0][3] = x;
             f[1][3] = y;
             f[2][3] = z;
@@ -52,8 +52,8 @@ namespace animray {
         }
 
         /// Return the backward matrix for the translation
-        matrix<W> backward() const {
-            matrix<W> b;
+        affine_matrix<W> backward() const {
+            affine_matrix<W> b;
             b[0][3] = -x;
             b[1][3] = -y;
             b[2][3] = -z;
@@ -64,9 +64,9 @@ namespace animray {
 
     /// Return matrices for scaling along each axis.
     template<typename W>
-    std::pair<matrix<W>, matrix<W>>
+    std::pair<affine_matrix<W>, affine_matrix<W>>
             scale(const W &sx, const W &sy, const W &sz) {
-        matrix<W> f, b;
+        affine_matrix<W> f, b;
         f[0][0] = sx;
         b[0][0] = W(1) / sx;
         f[1][1] = sy;
@@ -79,8 +79,8 @@ namespace animray {
 
     /// Rotate about the x-axis
     template<typename W>
-    std::pair<matrix<W>, matrix<W>> rotate_x(const W &radians) {
-        matrix<W> f, b;
+    std::pair<affine_matrix<W>, affine_matrix<W>> rotate_x(const W &radians) {
+        affine_matrix<W> f, b;
         f[0][0] = W(1);
         b[0][0] = W(1);
         f[1][1] = cos(radians);
@@ -91,16 +91,14 @@ namespace animray {
         b[2][1] = sin(-radians);
         f[2][2] = cos(radians);
         b[2][2] = cos(-radians);
-        f[3][3] = W(1);
-        b[3][3] = W(1);
         return std::make_pair(f, b);
     }
 
 
     /// Rotate about the x-axis
     template<typename W>
-    std::pair<matrix<W>, matrix<W>> rotate_y(const W &radians) {
-        matrix<W> f, b;
+    std::pair<affine_matrix<W>, affine_matrix<W>> rotate_y(const W &radians) {
+        affine_matrix<W> f, b;
         f[0][0] = cos(radians);
         b[0][0] = cos(-radians);
         f[0][2] = sin(radians);
@@ -111,16 +109,14 @@ namespace animray {
         b[2][0] = -sin(-radians);
         f[2][2] = cos(radians);
         b[2][2] = cos(-radians);
-        f[3][3] = W(1);
-        b[3][3] = W(1);
         return std::make_pair(f, b);
     }
 
 
     /// Rotate about the x-axis
     template<typename W>
-    std::pair<matrix<W>, matrix<W>> rotate_z(const W &radians) {
-        matrix<W> f, b;
+    std::pair<affine_matrix<W>, affine_matrix<W>> rotate_z(const W &radians) {
+        affine_matrix<W> f, b;
         f[0][0] = cos(radians);
         b[0][0] = cos(-radians);
         f[0][1] = -sin(radians);
@@ -131,8 +127,6 @@ namespace animray {
         b[1][1] = cos(-radians);
         f[2][2] = W(1);
         b[2][2] = W(1);
-        f[3][3] = W(1);
-        b[3][3] = W(1);
         return std::make_pair(f, b);
     }
 
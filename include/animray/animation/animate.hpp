@@ -23,6 +23,8 @@
 #pragma once
 
 
+#include <animray/animation/frame-cache.hpp>
+
 #include <utility>
 #include <functional>
 
@@ -51,9 +53,12 @@ namespace animray {
     };
 
 
-    /// Base for attaching animations to attributes
+    /// Base for attaching animations to attributes. The value is only
+    /// calculated once for each frame
     template<typename T>
     class animate : public T {
+        frame_cache<std::invoke_result_t<T const &, double>> cache;
+
       public:
         /// Pass constructor arguments to superclass
         template<typename... A>
@@ -62,7 +67,9 @@ namespace animray {
         /// Strip the frame out of the ray type
         template<typename R>
         auto operator()(const R &ray) const {
-            return T::operator()(ray.frame);
+            return cache(ray.frame, [&ray, this](auto) {
+                return T::operator()(ray.frame);
+            });
         }
     };
 
@@ -74,9 +81,9 @@ namespace animray {
 
       public:
         /// Default construct return a default T
-        animate<std::function<T(F)>>() : function([](F) { return T(); }) {}
+        animate() : function([](F) { return T(); }) {}
         /// Initialise with the lambda to use
-        animate<std::function<T(F)>>(std::function<T(F)> f) : function(f) {}
+        animate(std::function<T(F)> f) : function(f) {}
 
         /// The type of the value of R
         /// TODO: We don't really want this here
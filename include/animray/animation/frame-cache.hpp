@@ -0,0 +1,150 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_ANIMATION_FRAME_CACHE_HPP
+#define ANIMRAY_ANIMATION_FRAME_CACHE_HPP
+#pragma once
+
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+
+namespace animray {
+
+
+    /**
+     * # Frame cache
+     *
+     * Remembers the values an animation produced for the frames it was
+     * last asked about. Every ray a `stacatto_movie` produces for a frame
+     * carries the same frame number, so this turns one evaluation per ray
+     * into one per frame.
+     *
+     * Only whole frame numbers are stored. There are two slots, and a frame
+     * always goes in the one for its parity, so frames that are rendered
+     * one after the other, and may overlap, don't push each other out. The
+     * frame times of a `movie` are jittered and are almost never repeated,
+     * so they are calculated every time without touching the cache.
+     *
+     * Each slot is a sequence lock. Readers never block or write, and if a
+     * read overlaps an update the value is simply calculated again. Only
+     * one writer at a time stores its result, the others just return what
+     * they calculated. All of the shared state is held in atomics so the
+     * value must be trivially copyable.
+     *
+     * Frames are keyed as `double`s which is exact for integral frame
+     * numbers.
+     */
+    template<typename V, typename F = double>
+    class frame_cache {
+        static_assert(
+                std::is_trivially_copyable_v<V>,
+                "The cached value is copied a word at a time");
+
+        using word_type = std::uint64_t;
+        static constexpr std::size_t words =
+                (sizeof(V) + sizeof(word_type) - 1) / sizeof(word_type);
+        using buffer_type = std::array<word_type, words>;
+
+        /// A cached frame. Each is kept on its own cache line
+        struct alignas(64) slot_type {
+            /// Zero when empty, otherwise odd whilst it is being updated
+            std::atomic<std::uint64_t> sequence{};
+            std::atomic<F> frame{};
+            std::array<std::atomic<word_type>, words> value{};
+        };
+        mutable std::array<slot_type, 2> slots{};
+
+      public:
+        /// The type of value stored
+        using value_type = V;
+        /// The type the frame is keyed on
+        using frame_type = F;
+
+        constexpr frame_cache() noexcept {}
+        /// Copies start off empty
+        constexpr frame_cache(frame_cache const &) noexcept {}
+        frame_cache &operator=(frame_cache const &) noexcept {
+            clear();
+            return *this;
+        }
+
+        /// Forget the cached values. Must not be called whilst rendering
+        void clear() noexcept {
+            for (auto &slot : slots) {
+                slot.sequence.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /// Return the value for frame `f`, calling `calculate(f)` if it is
+        /// not already cached
+        template<typename C>
+        V operator()(F const f, C &&calculate) const {
+            /// The range check also turns away NaN
+            if (not(std::abs(f) < F(std::int64_t{1} << 62))
+                or F(std::int64_t(f)) != f) {
+                return calculate(f);
+            }
+            auto &slot = slots[std::size_t(std::int64_t(f) & 1)];
+            auto const before = slot.sequence.load(std::memory_order_acquire);
+            if (before and not(before & 1)
+                and slot.frame.load(std::memory_order_relaxed) == f) {
+                auto const buffer = [&]<std::size_t... W>(
+                                            std::index_sequence<W...>) {
+                    return buffer_type{
+                            slot.value[W].load(std::memory_order_relaxed)...};
+                }(std::make_index_sequence<words>{});
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == before) {
+                    std::array<std::byte, sizeof(V)> bytes;
+                    std::memcpy(bytes.data(), buffer.data(), sizeof(V));
+                    return std::bit_cast<V>(bytes);
+                }
+            }
+            V const calculated = calculate(f);
+            auto expected = before;
+            if (not(before & 1)
+                and slot.sequence.compare_exchange_strong(
+                        expected, before + 1, std::memory_order_relaxed)) {
+                std::atomic_thread_fence(std::memory_order_release);
+                buffer_type buffer{};
+                std::memcpy(buffer.data(), &calculated, sizeof(V));
+                slot.frame.store(f, std::memory_order_relaxed);
+                for (std::size_t w{}; w < words; ++w) {
+                    slot.value[w].store(buffer[w], std::memory_order_relaxed);
+                }
+                slot.sequence.store(before + 2, std::memory_order_release);
+            }
+            return calculated;
+        }
+    };
+
+}
+
+
+#endif // ANIMRAY_ANIMATION_FRAME_CACHE_HPP
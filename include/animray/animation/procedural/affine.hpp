@@ -23,9 +23,13 @@
 #pragma once
 
 
-#include <animray/matrix.hpp>
+#include <animray/affine-matrix.hpp>
 #include <animray/animation/animate.hpp>
+#include <animray/animation/frame-cache.hpp>
 #include <animray/interpolation/linear.hpp>
+#include <animray/ray.hpp>
+
+#include <optional>
 
 
 namespace animray::animation {
@@ -37,6 +41,8 @@ namespace animray::animation {
         std::add_pointer_t<T> lambda;
         typename W::value_type start{}, end{};
         std::size_t frames{};
+        /// The forward and backward matrices for the last frame
+        frame_cache<std::array<W, 2>> cache;
 
       public:
         /// The type of object that can be moved
@@ -68,13 +74,19 @@ namespace animray::animation {
             start = s;
             end = e;
             frames = f;
+            cache.clear();
             return *this;
         }
 
         /// Calculate the transformation matrix
         template<typename R>
         std::pair<W, W> matrices(const R &ray) const {
-            return lambda(interpolation::linear(start, end, ray.frame, frames));
+            auto const m = cache(ray.frame, [&ray, this](auto) {
+                auto const t = lambda(
+                        interpolation::linear(start, end, ray.frame, frames));
+                return std::array<W, 2>{t.first, t.second};
+            });
+            return {m[0], m[1]};
         }
 
         /// Ray intersection
@@ -91,11 +103,17 @@ namespace animray::animation {
             }
         }
 
-        /// Occlusion check
+        /// Occlusion check for anything closer than `t_max`
         template<typename R, typename E>
-        bool occludes(const R &by, const E epsilon) const {
+        bool occludes(
+                const R &by,
+                const E epsilon,
+                local_coord_type const t_max =
+                        unbounded<local_coord_type>) const {
             std::pair<W, W> transform(matrices(by));
-            return instance.occludes(by * transform.first, epsilon);
+            return instance.occludes(
+                    by * transform.first, epsilon,
+                    transform_distance(by, transform.first, t_max));
         }
 
       private:
@@ -104,7 +122,7 @@ namespace animray::animation {
 
     template<typename A, typename B, typename E, typename O>
     affine(A, B, E, std::size_t, O) -> affine<
-            matrix<typename O::local_coord_type>,
+            affine_matrix<typename O::local_coord_type>,
             std::remove_pointer_t<A>,
             O>;
 
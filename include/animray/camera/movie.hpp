@@ -98,9 +98,14 @@ namespace animray {
         template<typename S>
         ray_type operator()(S x, S y) const {
             ray_type ray{frame_camera(x, y)};
-            ray.frame(frame + J::sample() * shutter);
+            ray.frame = frame + J::sample() * shutter;
             return ray;
         }
+
+        /// The frame time at which the shutter opens
+        T shutter_open() const { return frame; }
+        /// The frame time at which the shutter closes
+        T shutter_close() const { return frame + shutter; }
     };
 
 
@@ -24,6 +24,7 @@
 
 
 #include <animray/camera/flat.hpp>
+#include <animray/ray-packet.hpp>
 
 
 namespace animray {
@@ -66,6 +67,20 @@ namespace animray {
                     end_type(pc.x, pc.y, focal_plane + focal_length));
         }
 
+        /// Build a packet of rays for the block of `W` by `H` pixels whose
+        /// top left is at the requested pixel. The lanes are in row order
+        template<std::size_t W, std::size_t H = W>
+        ray_packet<local_coord_type, W * H>
+                packet(resolution_type x, resolution_type y) const {
+            ray_packet<local_coord_type, W * H> rays;
+            for (std::size_t row{}; row < H; ++row) {
+                for (std::size_t column{}; column < W; ++column) {
+                    rays.set(row * W + column, (*this)(x + column, y + row));
+                }
+            }
+            return rays;
+        }
+
       private:
         /// The location of the focal plane for the camera
         extents_type focal_plane;
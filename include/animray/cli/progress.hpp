@@ -22,56 +22,229 @@
 
 
 #include <animray/cli/main.hpp>
-#include <animray/formats/targa.hpp>
+#include <animray/formats/save.hpp>
+#include <animray/formats/y4m.hpp>
+#include <animray/threading/output-queue.hpp>
+#include <animray/threading/pool.hpp>
 #include <animray/threading/sub-panel.hpp>
+#include <chrono>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
 
 
 namespace animray {
 
 
+    namespace cli {
+        /// Saves rendered frames on a thread of its own so that the next
+        /// frame can render while the last one is written. At most
+        /// `frames` frames are held waiting to be written. The file format
+        /// comes from the file name's extension, and PNG files are
+        /// compressed on the pool if one is given. The time taken to write
+        /// each frame is reported by `print_written`.
+        ///
+        /// Frames saved to a `.y4m` file are all added to the same video
+        /// stream, which is opened when the first frame is saved
+        class frame_output {
+            threading::pool *workers;
+            std::optional<y4m_stream> video;
+            threading::output_queue queue;
+            std::mutex mutex;
+            std::vector<std::pair<std::filesystem::path, double>> written;
+
+          public:
+            explicit frame_output(
+                    std::size_t const frames = 2,
+                    threading::pool *const w = {})
+            : workers{w}, queue{frames} {}
+            /// Waits for the frames still queued to be written. Errors are
+            /// only printed, so call `flush` first to see them
+            ~frame_output() {
+                try {
+                    queue.flush();
+                } catch (std::exception const &e) {
+                    std::cerr << e.what() << '\n';
+                }
+                print_written(std::cout);
+            }
+
+            /// Wait for the frames still queued to be written. Throws the
+            /// first error from writing a frame
+            void flush() {
+                queue.flush();
+                print_written(std::cout);
+            }
+
+            /// Queue a frame to be saved. Waits while the queue is full
+            template<typename F>
+            void save(std::filesystem::path filename, F image) {
+                queue.push([this, filename = std::move(filename),
+                            image = std::make_shared<F const>(
+                                    std::move(image))]() {
+                    auto const started = std::chrono::steady_clock::now();
+                    if (not streams_frames(filename)) {
+                        animray::save(filename, *image, workers);
+                    } else if constexpr (y4m_stream::accepts<F>) {
+                        if (not video) { video.emplace(filename); }
+                        video->frame(*image);
+                    } else {
+                        throw std::invalid_argument{
+                                "Y4M video needs 8 bit frames"};
+                    }
+                    std::chrono::duration<double> const taken =
+                            std::chrono::steady_clock::now() - started;
+                    std::lock_guard lock{mutex};
+                    written.emplace_back(filename, taken.count());
+                });
+            }
+
+            /// True if every frame saved to this file goes into one stream,
+            /// rather than each frame having a file of its own
+            static bool streams_frames(std::filesystem::path const &filename) {
+                return filename.extension() == ".y4m";
+            }
+
+            /// Print a line for each frame written since the last call
+            void print_written(std::ostream &o) {
+                std::lock_guard lock{mutex};
+                for (auto const &[filename, seconds] : written) {
+                    o << filename << " written in " << seconds << "s\n";
+                }
+                written.clear();
+            }
+        };
+    }
+
+
+    /// Start rendering a frame on the pool. The returned function waits
+    /// for the frame, printing progress as the panels are done, and then
+    /// queues it to be saved. It must be called before `output` is
+    /// destroyed
     template<typename film_type, typename P>
-    inline film_type cli_render_frame(
+    inline std::function<void()> cli_queue_frame(
             cli::arguments const &args,
             std::optional<std::size_t> const frame,
-            std::size_t const threads,
-            P const pixels) {
-        threading::sub_panel_progress progress{args.width, args.height};
-        std::promise<film_type> promise;
-        auto result = promise.get_future();
-        std::thread{[threads, &args, &pixels, &progress,
-                     promise = std::move(promise)]() mutable {
-            promise.set_value(animray::threading::sub_panel<film_type>(
-                    progress, threads, args.width, args.height, pixels));
-        }}.detach();
+            threading::pool &workers,
+            cli::frame_output &output,
+            P pixels) {
+        auto const started = std::chrono::steady_clock::now();
+        auto const progress = std::make_shared<threading::sub_panel_progress>(
+                args.width, args.height, workers.size());
+        auto const result = std::make_shared<std::future<film_type>>(
+                threading::sub_panel<film_type>(
+                        workers, *progress, args.width, args.height,
+                        std::move(pixels)));
         auto filename = args.output_filename;
-        if (frame) {
-            filename.replace_extension(std::to_string(*frame) + ".tga");
+        if (frame and not cli::frame_output::streams_frames(filename)) {
+            auto const extension = filename.has_extension()
+                    ? filename.extension().string()
+                    : std::string{".tga"};
+            filename.replace_extension(std::to_string(*frame) + extension);
         }
-        auto const print = [&]() {
-            std::cout << filename << ' ' << args.width << 'x' << args.height
-                      << ' ' << progress.count.load() << '/'
-                      << progress.count_limit << " (" << progress.panel_size_x
-                      << 'x' << progress.panel_size_y << ")\r" << std::flush;
-        };
-        do {
+        return [&output, started, progress, result,
+                filename = std::move(filename), width = args.width,
+                height = args.height]() {
+            auto const print = [&]() {
+                output.print_written(std::cout);
+                std::cout << filename << ' ' << width << 'x' << height << ' '
+                          << progress->count.load() << '/'
+                          << progress->count_limit << " ("
+                          << progress->panel_size_x << 'x'
+                          << progress->panel_size_y << ")\r" << std::flush;
+            };
+            do {
+                print();
+            } while (result->wait_for(std::chrono::milliseconds{100})
+                     != std::future_status::ready);
             print();
-        } while (result.wait_for(std::chrono::milliseconds{100})
-                 != std::future_status::ready);
-        print();
-        std::cout << '\n';
-        auto rendered = result.get();
-        animray::targa(filename, rendered);
-        return rendered;
+            std::chrono::duration<double> const taken =
+                    std::chrono::steady_clock::now() - started;
+            std::cout << " rendered in " << taken.count() << "s\n";
+            output.save(filename, result->get());
+        };
     }
 
 
+    /// Render a frame on the pool, printing progress as the panels are
+    /// done, and then queue it to be saved. Returns once the frame has
+    /// rendered, so the scene it uses can be changed for the next frame
     template<typename film_type, typename P>
-    inline film_type cli_render(
-            cli::arguments const &args, std::size_t const threads, P pixels) {
-        return cli_render_frame<film_type>(
-                args, {}, threads, std::move(pixels));
+    inline void cli_render_frame(
+            cli::arguments const &args,
+            std::optional<std::size_t> const frame,
+            threading::pool &workers,
+            cli::frame_output &output,
+            P pixels) {
+        cli_queue_frame<film_type>(
+                args, frame, workers, output, std::move(pixels))();
     }
 
 
+    namespace cli {
+        /// The threads and output queue used to render and save a sequence
+        /// of frames. Call `finish` after the last frame so that any error
+        /// writing the frames is thrown.
+        ///
+        /// Each frame is queued on the pool before waiting for the one
+        /// before it, so the threads move straight on to the next frame as
+        /// the tiles of the last one run out. The pixel function given to
+        /// `render` must therefore stay usable, and the scene it draws must
+        /// not change, until the next call to `render`, `wait` or `finish`
+        /// returns
+        class frame_renderer {
+            /// Finishes the frame queued last. It outlives the pool so that
+            /// the progress it holds outlives the frame's tiles
+            std::function<void()> pending;
+            threading::pool workers;
+            frame_output output;
+
+          public:
+            explicit frame_renderer(std::size_t const threads)
+            : workers{threads}, output{2, &workers} {}
+
+            /// Queue a frame, then wait for the frame before it and queue
+            /// that one to be saved
+            template<typename film_type, typename P>
+            void render(
+                    arguments const &args,
+                    std::optional<std::size_t> const frame,
+                    P pixels) {
+                auto previous = std::exchange(
+                        pending,
+                        cli_queue_frame<film_type>(
+                                args, frame, workers, output,
+                                std::move(pixels)));
+                if (previous) { previous(); }
+            }
+
+            /// Wait for the frame queued last to render, so that the scene
+            /// can be changed
+            void wait() {
+                if (auto last = std::exchange(pending, {}); last) { last(); }
+            }
+
+            /// Wait for every frame to render and be written
+            void finish() {
+                wait();
+                output.flush();
+            }
+        };
+    }
+
+
+    /// Render a single frame using `threads` threads and save it
+    template<typename film_type, typename P>
+    inline void cli_render(
+            cli::arguments const &args, std::size_t const threads, P pixels) {
+        cli::frame_renderer renderer{threads};
+        renderer.render<film_type>(args, {}, std::move(pixels));
+        renderer.finish();
+    }
+
 }
@@ -29,10 +29,11 @@
 namespace animray {
 
 
-    /// YUV colour space. The luma channel can take on any value, and
-    /// chroma values are between -0.5 and + 0.5 for floating point types.
-    /// For digital use this colour format is properly called YCrCb, but
-    /// nobody uses the proper name.
+    /// YUV colour space. The luma channel can take on any value. For
+    /// floating point types converted from RGB in the range [0...1] the `u`
+    /// channel is within ±0.436 and `v` within ±0.615. For digital use this
+    /// colour format is properly called YCrCb, but nobody uses the proper
+    /// name.
     template<typename D>
     class yuv : private detail::array_based<D, 3> {
         typedef detail::array_based<D, 3> superclass;
@@ -79,18 +80,47 @@ namespace animray {
     };
 
 
+    namespace detail {
+        /// The BT.709 luma weights and the divisors that take `b - y` and
+        /// `r - y` to `u` and `v`. Both conversions are worked out from
+        /// these
+        struct yuv_weights {
+            static constexpr double red = 0.2126, green = 0.7152,
+                                    blue = 0.0722, u = 2.12798, v = 1.28033;
+        };
+    }
+
+
     /// Allow conversion from YUV to RGB for float versions. Output RGB range
     /// is [0...1] for each channel, but is un-clamped, so some values may be
     /// out of range. Values are for the HDTV (BT.709) standard
     template<typename D>
     struct detail::color_conversion<rgb<D>, yuv<D>> {
         auto convert(yuv<D> const &c) {
-            auto const r = c.y() + D{1.28033} * c.v();
-            auto const g = c.y() - D{0.21482} * c.u() - D{0.38059} * c.v();
-            auto const b = c.y() + D{2.12798} * c.u();
+            using w = yuv_weights;
+            /// Green is what is left of the luma after red and blue
+            constexpr D gu = D(w::blue * w::u / w::green),
+                        gv = D(w::red * w::v / w::green);
+            auto const r = c.y() + D(w::v) * c.v();
+            auto const g = c.y() - gu * c.u() - gv * c.v();
+            auto const b = c.y() + D(w::u) * c.u();
             return rgb<D>{r, g, b};
         }
     };
 
 
+    /// Allow conversion from RGB to YUV for float versions. This is the
+    /// inverse of the conversion to RGB above, so for RGB in the range
+    /// [0...1] the `u` channel is within ±0.436 and `v` within ±0.615
+    template<typename D>
+    struct detail::color_conversion<yuv<D>, rgb<D>> {
+        auto convert(rgb<D> const &c) {
+            using w = yuv_weights;
+            auto const y = D(w::red) * c.red() + D(w::green) * c.green()
+                    + D(w::blue) * c.blue();
+            return yuv<D>{y, (c.blue() - y) / D(w::u), (c.red() - y) / D(w::v)};
+        }
+    };
+
+
 }
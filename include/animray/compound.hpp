@@ -25,8 +25,11 @@
 
 #include <animray/emission.hpp>
 #include <animray/functional/fold.hpp>
+#include <animray/geometry/bounding-box.hpp>
 #include <animray/intersection.hpp>
+#include <animray/ray-packet.hpp>
 #include <animray/shader.hpp>
+#include <animray/unbounded.hpp>
 
 #include <optional>
 #include <tuple>
@@ -99,6 +102,18 @@ namespace animray {
         template<typename... G>
         compound(G... gs) : instances{std::forward<G>(gs)...} {}
 
+        /// The bounds of all of the geometry
+        template<typename... P>
+        bounding_box<local_coord_type> bounds(P const &...p) const {
+            return std::apply(
+                    [&](const auto &...geom) {
+                        bounding_box<local_coord_type> b;
+                        (b.merge(geom.bounds(p...)), ...);
+                        return b;
+                    },
+                    instances);
+        }
+
         /// Forward the intersection check to the geometry instances.
         /// Return the closest intersection, `null` if none are found.
         template<typename R, typename E>
@@ -136,15 +151,70 @@ namespace animray {
                     .second;
         }
 
-        /// Calculate whether this object occludes the ray or not
+        /// Calculate whether this object occludes the ray before `t_max`
         template<typename R>
-        bool occludes(const R &by, const local_coord_type epsilon) const {
+        bool occludes(
+                const R &by,
+                const local_coord_type epsilon,
+                local_coord_type const t_max =
+                        unbounded<local_coord_type>) const {
+            return std::apply(
+                    [&by, epsilon, t_max](const auto &...geom) -> bool {
+                        return (geom.occludes(by, epsilon, t_max) || ...);
+                    },
+                    instances);
+        }
+
+        /// Update the lanes of `closest` for which one of the geometry
+        /// instances is nearer
+        template<typename PD, std::size_t N, typename E>
+        void intersects(
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                packet_intersection<intersection_type, N> &closest) const {
+            std::apply(
+                    [&](const auto &...geom) {
+                        (packet_intersects(geom, by, epsilon, closest), ...);
+                    },
+                    instances);
+        }
+
+        /// The active lanes blocked by any of the geometry before their
+        /// `t_max`
+        template<typename PD, std::size_t N, typename E>
+        lane_mask<N> occludes(
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                std::array<local_coord_type, N> const &t_max) const {
             return std::apply(
-                    [&by, epsilon](const auto &...geom) -> bool {
-                        return (geom.occludes(by, epsilon) || ...);
+                    [&](const auto &...geom) {
+                        lane_mask<N> blocked{};
+                        ((blocked = either(
+                                  blocked, geom.occludes(by, epsilon, t_max))),
+                         ...);
+                        return blocked;
                     },
                     instances);
-            return false;
+        }
+
+      private:
+        /// Run the packet through one of the geometry instances and wrap
+        /// up the lanes that it struck
+        template<typename G, typename PD, std::size_t N, typename E>
+        static void packet_intersects(
+                G const &geom,
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                packet_intersection<intersection_type, N> &closest) {
+            packet_intersection<typename G::intersection_type, N> mine{
+                    closest.distance};
+            geom.intersects(by, epsilon, mine);
+            for (std::size_t lane{}; lane < N; ++lane) {
+                if (mine.hit[lane]) {
+                    closest.distance[lane] = mine.distance[lane];
+                    closest.hit[lane].emplace(std::move(*mine.hit[lane]));
+                }
+            }
         }
     };
 
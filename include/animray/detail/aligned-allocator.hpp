@@ -0,0 +1,71 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_DETAIL_ALIGNED_ALLOCATOR_HPP
+#define ANIMRAY_DETAIL_ALIGNED_ALLOCATOR_HPP
+#pragma once
+
+
+#include <cstddef>
+#include <new>
+
+
+namespace animray::detail {
+
+
+    /// The size of a cache line
+    constexpr std::size_t cache_line_size = 64;
+
+
+    /// An allocator whose memory starts on an `A` byte boundary
+    template<typename T, std::size_t A = cache_line_size>
+    struct aligned_allocator {
+        using value_type = T;
+        static constexpr std::align_val_t alignment{
+                A < alignof(T) ? alignof(T) : A};
+
+        template<typename U>
+        struct rebind {
+            using other = aligned_allocator<U, A>;
+        };
+
+        constexpr aligned_allocator() noexcept = default;
+        template<typename U>
+        constexpr aligned_allocator(aligned_allocator<U, A> const &) noexcept {}
+
+        T *allocate(std::size_t const n) {
+            return static_cast<T *>(::operator new(n * sizeof(T), alignment));
+        }
+        void deallocate(T *const p, std::size_t) noexcept {
+            ::operator delete(p, alignment);
+        }
+
+        template<typename U>
+        constexpr bool
+                operator==(aligned_allocator<U, A> const &) const noexcept {
+            return true;
+        }
+    };
+
+
+}
+
+
+#endif // ANIMRAY_DETAIL_ALIGNED_ALLOCATOR_HPP
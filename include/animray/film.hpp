@@ -23,17 +23,136 @@
 #pragma once
 
 
+#include <animray/detail/aligned-allocator.hpp>
 #include <animray/extents2d.hpp>
 #include <felspar/exceptions/underflow_error.hpp>
+#include <concepts>
 #include <functional>
+#include <span>
 #include <vector>
 
 
 namespace animray {
 
 
-    /// A film represents a raster of pixel data in columns
-    template<typename C, typename E = std::size_t>
+    /// The ways that a film can arrange its pixels in memory
+    namespace layout {
+
+
+        /// Each row of pixels follows the one before it
+        struct row_major {
+            /// The number of pixels that need to be stored
+            static constexpr std::size_t storage_size(
+                    std::size_t const width, std::size_t const height) {
+                return width * height;
+            }
+            /// The position of a pixel in the storage
+            static constexpr std::size_t index(
+                    std::size_t const x,
+                    std::size_t const y,
+                    std::size_t const width) {
+                return y * width + x;
+            }
+            /// Call `fn(index, x, y)` for every pixel in storage order
+            template<typename F>
+            static void for_each_position(
+                    std::size_t const width, std::size_t const height, F fn) {
+                std::size_t index{};
+                for (std::size_t y{}; y < height; ++y) {
+                    for (std::size_t x{}; x < width; ++x) {
+                        fn(index++, x, y);
+                    }
+                }
+            }
+        };
+
+
+        /**
+         * The film is broken into square tiles of `S` by `S` pixels which
+         * follow each other a row of tiles at a time. The pixels within a
+         * tile are in Morton (Z curve) order so that pixels close together
+         * on the film are also close together in memory. The right and
+         * bottom edges are padded out to whole tiles.
+         */
+        template<std::size_t S = 8>
+        struct tiled {
+            static_assert(
+                    S > 0 and (S & (S - 1)) == 0,
+                    "The tile size must be a power of 2");
+            /// The width and height of a tile
+            static constexpr std::size_t tile_size = S;
+            /// The number of pixels in a tile
+            static constexpr std::size_t tile_pixels = S * S;
+
+            /// The number of tiles needed to cover `n` pixels
+            static constexpr std::size_t tiles(std::size_t const n) {
+                return (n + S - 1) / S;
+            }
+            /// The Morton order of a position within a tile
+            static constexpr std::size_t
+                    morton(std::size_t const x, std::size_t const y) {
+                std::size_t m{};
+                for (std::size_t bit{}; (std::size_t{1} << bit) < S; ++bit) {
+                    m |= ((x >> bit) & 1) << (2 * bit);
+                    m |= ((y >> bit) & 1) << (2 * bit + 1);
+                }
+                return m;
+            }
+
+            /// The number of pixels that need to be stored
+            static constexpr std::size_t storage_size(
+                    std::size_t const width, std::size_t const height) {
+                return tiles(width) * tiles(height) * tile_pixels;
+            }
+            /// The position of a pixel in the storage
+            static constexpr std::size_t index(
+                    std::size_t const x,
+                    std::size_t const y,
+                    std::size_t const width) {
+                return ((y / S) * tiles(width) + x / S) * tile_pixels
+                        + morton(x % S, y % S);
+            }
+            /// Call `fn(index, x, y)` for every pixel in storage order. The
+            /// padding is skipped
+            template<typename F>
+            static void for_each_position(
+                    std::size_t const width, std::size_t const height, F fn) {
+                std::size_t index{};
+                for (std::size_t ty{}; ty < tiles(height); ++ty) {
+                    for (std::size_t tx{}; tx < tiles(width); ++tx) {
+                        for (std::size_t m{}; m < tile_pixels; ++m, ++index) {
+                            std::size_t x{tx * S}, y{ty * S};
+                            for (std::size_t bit{};
+                                 (std::size_t{1} << bit) < S; ++bit) {
+                                x |= ((m >> (2 * bit)) & 1) << bit;
+                                y |= ((m >> (2 * bit + 1)) & 1) << bit;
+                            }
+                            if (x < width and y < height) { fn(index, x, y); }
+                        }
+                    }
+                }
+            }
+        };
+
+
+    }
+
+
+    /**
+     * # Film
+     *
+     * A film represents a raster of pixel data. The pixels are held in a
+     * single cache line aligned buffer arranged according to the layout `L`.
+     * Pixels are addressed as `film[x][y]`, which is not bounds checked.
+     *
+     * Row major films can hand out each row as a `std::span` and tiled films
+     * each tile, so that code writing or reading a whole film can walk
+     * through memory in order.
+     */
+    template<
+            typename C,
+            typename E = std::size_t,
+            typename L = layout::row_major>
     class film {
       public:
         /// The colour type
@@ -44,79 +163,182 @@ namespace animray {
         using extents_type = extents2d<extents_value_type>;
         /// The extents size type
         using size_type = typename extents_type::size_type;
+        /// The memory layout
+        using layout_type = L;
+        /// The type of the pixel storage
+        using storage_type =
+                std::vector<color_type, detail::aligned_allocator<color_type>>;
+
+        /// A view of a single column of image data
+        template<typename F>
+        class column_view {
+            friend class film;
+            F *image;
+            size_type x;
+            column_view(F *f, size_type c) : image{f}, x{c} {}
+
+          public:
+            auto &operator[](size_type const y) const {
+                return image->pixel(x, y);
+            }
+        };
         /// The type of a single column of image data
-        using column_type = std::vector<color_type>;
+        using column_type = column_view<film>;
+        /// The type of a single non-mutable column of image data
+        using const_column_type = column_view<film const>;
+
+        /// A rectangular part of the film. Separate regions of the same film
+        /// can be written to from different threads at the same time
+        class region_view {
+            friend class film;
+            film *image;
+            extents_type area;
+            region_view(film *f, extents_type const &e) : image{f}, area{e} {}
+
+          public:
+            /// The part of the film this covers
+            extents_type const &extents() const { return area; }
+
+            /// Set every pixel in the region to `fn(x, y)`, where `x` and
+            /// `y` are film co-ordinates. Each row of a row major film is
+            /// written through its span
+            template<typename F>
+            void fill(F &&fn) const {
+                size_type const x0 = area.lower_left.x,
+                                y0 = area.lower_left.y;
+                for (size_type y = y0; y <= area.top_right.y; ++y) {
+                    if constexpr (std::same_as<L, layout::row_major>) {
+                        auto const row =
+                                image->row(y).subspan(x0, area.width());
+                        for (size_type x{}; x < row.size(); ++x) {
+                            row[x] = fn(x0 + x, y);
+                        }
+                    } else {
+                        for (size_type x = x0; x <= area.top_right.x; ++x) {
+                            image->pixel(x, y) = fn(x, y);
+                        }
+                    }
+                }
+            }
+        };
 
         /// Default constructor
         film() = default;
 
-        /// Construct an empty targa of the given size
+        /// Construct an empty film of the given size
         film(size_type width, size_type height, const C &colour = C())
-        : columns(width, column_type(height, colour)) {
+        : columns{width}, rows{height} {
             check_width_height(width, height);
+            pixels.assign(layout_type::storage_size(width, height), colour);
         }
 
         /// Construct a film of a given size with a lambda telling us which
-        /// colors to use
+        /// colors to use. The lambda is called in storage order
         film(size_type width,
              size_type height,
-             std::function<color_type(size_type, size_type)> fn) {
+             std::function<color_type(size_type, size_type)> fn)
+        : columns{width}, rows{height} {
             check_width_height(width, height);
-            for (size_type c{}; c < width; ++c) {
-                columns.emplace_back();
-                column_type &col = columns.back();
-                for (size_type r{}; r < height; ++r) {
-                    col.push_back(fn(c, r));
-                }
-            }
-        }
-        film(size_type width,
-             size_type height,
-             std::function<color_type(size_type, size_type)>
-                     fn) requires std::is_copy_constructible_v<C> :
-        film{width, height} {
-            check_width_height(width, height);
-            for (size_type c{}; c < width; ++c) {
-                column_type &col = columns[c];
-                for (size_type r{}; r < height; ++r) { col[r] = fn(c, r); }
-            }
+            pixels = storage_type(layout_type::storage_size(width, height));
+            layout_type::for_each_position(
+                    width, height,
+                    [this, &fn](std::size_t const index, size_type const x,
+                                size_type const y) {
+                        pixels[index] = fn(x, y);
+                    });
         }
 
         /// The width of the image
-        const size_type width() const { return columns.size(); }
+        const size_type width() const { return columns; }
         /// The height of the image
-        const size_type height() const { return columns[0].size(); }
+        const size_type height() const { return rows; }
         /// Return the extents of the image
         extents_type size() const {
             return extents_type(0, 0, width() - 1, height() - 1);
         }
 
-        /// Return a mutable row
-        column_type &operator[](size_type c) { return columns.at(c); }
-        /// Return a non-mutable row
-        const column_type &operator[](size_type c) const {
-            return columns.at(c);
+        /// Return a mutable column
+        column_type operator[](size_type c) { return {this, c}; }
+        /// Return a non-mutable column
+        const_column_type operator[](size_type c) const { return {this, c}; }
+
+        /// A single pixel
+        color_type &pixel(size_type const x, size_type const y) {
+            return pixels[layout_type::index(x, y, columns)];
+        }
+        /// A single pixel
+        color_type const &pixel(size_type const x, size_type const y) const {
+            return pixels[layout_type::index(x, y, columns)];
         }
 
-        /// Iterate the function across the image rows/columns
+        /// A part of the film, given in film co-ordinates, that can be
+        /// written to
+        region_view region(extents_type const &e) { return {this, e}; }
+
+        /// All of the pixels in storage order, including any padding
+        std::span<color_type> storage() { return pixels; }
+        /// All of the pixels in storage order, including any padding
+        std::span<color_type const> storage() const { return pixels; }
+
+        /// A mutable row of a row major film
+        std::span<color_type> row(size_type const y)
+            requires std::same_as<L, layout::row_major>
+        {
+            return {pixels.data() + y * columns, columns};
+        }
+        /// A non-mutable row of a row major film
+        std::span<color_type const> row(size_type const y) const
+            requires std::same_as<L, layout::row_major>
+        {
+            return {pixels.data() + y * columns, columns};
+        }
+
+        /// A mutable tile of a tiled film, with the pixels in Morton order
+        auto tile(size_type const tx, size_type const ty)
+            requires(not std::same_as<L, layout::row_major>)
+        {
+            return std::span<color_type, L::tile_pixels>{
+                    pixels.data() + tile_offset(tx, ty), L::tile_pixels};
+        }
+        /// A non-mutable tile of a tiled film, with the pixels in Morton
+        /// order
+        auto tile(size_type const tx, size_type const ty) const
+            requires(not std::same_as<L, layout::row_major>)
+        {
+            return std::span<color_type const, L::tile_pixels>{
+                    pixels.data() + tile_offset(tx, ty), L::tile_pixels};
+        }
+
+        /// Iterate the function across the image in storage order
         template<typename F>
         void for_each(F fn) const {
-            for (size_type c = 0; c < width(); ++c) {
-                const column_type &col = columns[c];
-                for (size_type r = 0; r < height(); ++r) { fn(col[r]); }
-            }
+            layout_type::for_each_position(
+                    columns, rows,
+                    [this, &fn](std::size_t const index, auto, auto) {
+                        fn(pixels[index]);
+                    });
         }
         /// Allow us to force iteration over the rows first
         template<typename F>
         void for_each_row(F fn) const {
-            for (size_type r = 0; r < height(); ++r) {
-                for (size_type c = 0; c < width(); ++c) { fn(columns[c][r]); }
+            if constexpr (std::same_as<L, layout::row_major>) {
+                for (auto const &p : pixels) { fn(p); }
+            } else {
+                for (size_type r = 0; r < height(); ++r) {
+                    for (size_type c = 0; c < width(); ++c) {
+                        fn(pixel(c, r));
+                    }
+                }
             }
         }
 
       private:
-        using columns_type = std::vector<column_type>;
-        columns_type columns;
+        size_type columns{}, rows{};
+        storage_type pixels;
+
+        std::size_t tile_offset(size_type const tx, size_type const ty) const {
+            return (ty * L::tiles(columns) + tx) * L::tile_pixels;
+        }
         void static check_width_height(size_type width, size_type height) {
             if (width < 1) {
                 throw felspar::underflow_error{
@@ -0,0 +1,275 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_FORMATS_DEFLATE_HPP
+#define ANIMRAY_FORMATS_DEFLATE_HPP
+#pragma once
+
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace animray::deflate {
+
+
+    /**
+     * # Deflate
+     *
+     * A small deflate (RFC 1951) compressor for the image formats that need
+     * it. Matches are found with a hash chain over the 32KB window and are
+     * coded with the fixed Huffman tables, which keeps the encoder short
+     * while still doing well on the long runs found in rendered frames.
+     *
+     * Separate pieces of data can be compressed on different threads and
+     * the results joined together. Every piece but the last ends with an
+     * empty stored block, so it finishes on a byte boundary, and matches
+     * never reach back into an earlier piece. The zlib (RFC 1950) Adler-32
+     * checksums of the pieces can be joined with `adler32_combine`.
+     */
+
+
+    /// The modulus used by Adler-32
+    constexpr std::uint32_t adler_base = 65521;
+
+
+    /// Continue an Adler-32 checksum over more bytes
+    inline std::uint32_t adler32(
+            std::span<std::uint8_t const> const data,
+            std::uint32_t const adler = 1) {
+        std::uint32_t a = adler & 0xffff, b = adler >> 16;
+        /// 5552 bytes is the most that can be summed before `b` could
+        /// overflow
+        for (std::size_t start{}; start < data.size(); start += 5552) {
+            auto const end = std::min(data.size(), start + 5552);
+            for (auto index = start; index != end; ++index) {
+                a += data[index];
+                b += a;
+            }
+            a %= adler_base;
+            b %= adler_base;
+        }
+        return a | (b << 16);
+    }
+
+
+    /// The Adler-32 checksum of two pieces of data one after the other,
+    /// given the checksum of each and the length of the second
+    inline std::uint32_t adler32_combine(
+            std::uint32_t const first,
+            std::uint32_t const second,
+            std::size_t const second_length) {
+        std::uint64_t const remainder = second_length % adler_base;
+        std::uint64_t a = first & 0xffff;
+        std::uint64_t b = (remainder * a) % adler_base;
+        a += (second & 0xffff) + adler_base - 1;
+        b += (first >> 16) + (second >> 16) + adler_base - remainder;
+        a %= adler_base;
+        b %= adler_base;
+        return std::uint32_t(a | (b << 16));
+    }
+
+
+    /// Continue a CRC-32 (as used by PNG and zip) over more bytes
+    inline std::uint32_t crc32(
+            std::span<std::uint8_t const> const data,
+            std::uint32_t const crc = 0) {
+        static auto const table = []() {
+            std::array<std::uint32_t, 256> t{};
+            for (std::uint32_t n{}; n != 256; ++n) {
+                std::uint32_t c = n;
+                for (int k{}; k != 8; ++k) {
+                    c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                }
+                t[n] = c;
+            }
+            return t;
+        }();
+        std::uint32_t c = ~crc;
+        for (auto const byte : data) {
+            c = table[(c ^ byte) & 0xff] ^ (c >> 8);
+        }
+        return ~c;
+    }
+
+
+    namespace detail {
+        /// Writes bit fields least significant bit first
+        class bit_writer {
+            std::vector<std::uint8_t> &out;
+            std::uint64_t pending = 0;
+            unsigned count = 0;
+
+          public:
+            explicit bit_writer(std::vector<std::uint8_t> &o) : out{o} {}
+
+            void bits(std::uint32_t const value, unsigned const n) {
+                pending |= std::uint64_t(value) << count;
+                count += n;
+                while (count >= 8) {
+                    out.push_back(std::uint8_t(pending));
+                    pending >>= 8;
+                    count -= 8;
+                }
+            }
+            /// Huffman codes are sent most significant bit first
+            void code(std::uint32_t const value, unsigned const n) {
+                std::uint32_t reversed{};
+                for (unsigned bit{}; bit != n; ++bit) {
+                    reversed |= ((value >> bit) & 1) << (n - 1 - bit);
+                }
+                bits(reversed, n);
+            }
+            /// Pad with zero bits up to the next byte
+            void align() {
+                if (count) { bits(0, 8 - count); }
+            }
+        };
+
+
+        /// Send a literal byte or the end of block marker using the fixed
+        /// Huffman table
+        inline void literal(bit_writer &out, unsigned const symbol) {
+            if (symbol < 144) {
+                out.code(0x30 + symbol, 8);
+            } else if (symbol < 256) {
+                out.code(0x190 + symbol - 144, 9);
+            } else if (symbol < 280) {
+                out.code(symbol - 256, 7);
+            } else {
+                out.code(0xc0 + symbol - 280, 8);
+            }
+        }
+
+
+        /// Send a match of `length` bytes `distance` bytes back
+        inline void match(
+                bit_writer &out,
+                unsigned const length,
+                unsigned const distance) {
+            static constexpr std::array<std::uint16_t, 29> length_base{
+                    3,  4,  5,  6,   7,   8,   9,   10,  11, 13,
+                    15, 17, 19, 23,  27,  31,  35,  43,  51, 59,
+                    67, 83, 99, 115, 131, 163, 195, 227, 258};
+            static constexpr std::array<std::uint8_t, 29> length_extra{
+                    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                    2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+            static constexpr std::array<std::uint16_t, 30> distance_base{
+                    1,    2,    3,    4,    5,    7,     9,     13,
+                    17,   25,   33,   49,   65,   97,    129,   193,
+                    257,  385,  513,  769,  1025, 1537,  2049,  3073,
+                    4097, 6145, 8193, 12289, 16385, 24577};
+            static constexpr std::array<std::uint8_t, 30> distance_extra{
+                    0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                    6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+            unsigned l = 28;
+            while (length_base[l] > length) { --l; }
+            literal(out, 257 + l);
+            out.bits(length - length_base[l], length_extra[l]);
+            unsigned d = 29;
+            while (distance_base[d] > distance) { --d; }
+            out.code(d, 5);
+            out.bits(distance - distance_base[d], distance_extra[d]);
+        }
+    }
+
+
+    /// Compress the data as a fixed Huffman block and append it to `out`.
+    /// If this is not the `last` piece of the stream it is followed by an
+    /// empty stored block so that more pieces can be appended
+    inline void compress(
+            std::span<std::uint8_t const> const data,
+            bool const last,
+            std::vector<std::uint8_t> &out) {
+        constexpr std::size_t window = 32768, max_length = 258,
+                              max_chain = 64, hash_bits = 15;
+        constexpr std::uint32_t none = ~std::uint32_t{};
+        std::vector<std::uint32_t> head(std::size_t{1} << hash_bits, none),
+                previous(std::min(data.size(), window), none);
+        auto const hash = [&](std::size_t const at) {
+            std::uint32_t const v = data[at] | (data[at + 1] << 8)
+                    | (data[at + 2] << 16);
+            return (v * 2654435761u) >> (32 - hash_bits);
+        };
+        auto const insert = [&](std::size_t const at) {
+            if (at + 2 < data.size()) {
+                auto &h = head[hash(at)];
+                previous[at % previous.size()] = h;
+                h = std::uint32_t(at);
+            }
+        };
+
+        detail::bit_writer bits{out};
+        bits.bits(last ? 1 : 0, 1);
+        bits.bits(1, 2); // Fixed Huffman codes
+        for (std::size_t at{}; at < data.size();) {
+            std::size_t best_length{}, best_distance{};
+            if (at + 2 < data.size()) {
+                std::size_t const limit =
+                        std::min(max_length, data.size() - at);
+                std::uint32_t candidate = head[hash(at)];
+                for (std::size_t chain{};
+                     candidate != none and chain != max_chain
+                     and at - candidate <= window - 1;
+                     ++chain) {
+                    std::size_t length{};
+                    while (length < limit
+                           and data[candidate + length] == data[at + length]) {
+                        ++length;
+                    }
+                    if (length > best_length) {
+                        best_length = length;
+                        best_distance = at - candidate;
+                        if (length == limit) { break; }
+                    }
+                    auto const next = previous[candidate % previous.size()];
+                    if (next == none or next >= candidate) { break; }
+                    candidate = next;
+                }
+            }
+            if (best_length >= 3) {
+                detail::match(bits, unsigned(best_length),
+                              unsigned(best_distance));
+                for (std::size_t end = at + best_length; at != end; ++at) {
+                    insert(at);
+                }
+            } else {
+                detail::literal(bits, data[at]);
+                insert(at++);
+            }
+        }
+        detail::literal(bits, 256);
+        if (not last) {
+            bits.bits(0, 3); // Stored block, not final
+            bits.align();
+            bits.bits(0x0000, 16);
+            bits.bits(0xffff, 16);
+        }
+        bits.align();
+    }
+
+
+}
+
+
+#endif // ANIMRAY_FORMATS_DEFLATE_HPP
@@ -0,0 +1,221 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_FORMATS_EXR_HPP
+#define ANIMRAY_FORMATS_EXR_HPP
+#pragma once
+
+
+#include <animray/film.hpp>
+#include <animray/color/rgb.hpp>
+#include <animray/formats/file.hpp>
+#include <animray/narrow.hpp>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+
+namespace animray {
+
+
+    /**
+     * # OpenEXR files
+     *
+     * Single part scan line OpenEXR files with uncompressed half float
+     * channels. Halves keep about three significant figures over a range
+     * from 6e-5 up to 65504, which is plenty for tone mapping later on and
+     * is half the size of a PFM file.
+     *
+     * Without compression every scan line is the same size, so the table of
+     * line offsets that comes after the header can be worked out before any
+     * pixels are converted. The lines are then written out one at a time
+     * and only a single line is ever held in memory.
+     *
+     * `film<rgb<float>>` is written with `B`, `G` and `R` channels and
+     * `film<float>` with a single `Y` channel.
+     */
+
+
+    /// Convert a float to the nearest half float, with ties going to the
+    /// even value. Values too large for a half become infinite
+    inline std::uint16_t half(float const f) noexcept {
+        auto const bits = std::bit_cast<std::uint32_t>(f);
+        std::uint16_t const sign = (bits >> 16) & 0x8000;
+        std::uint32_t const magnitude = bits & 0x7fff'ffff;
+        if (magnitude >= 0x7f80'0000) {
+            // Infinity stays infinite, and NaN keeps a mantissa bit set
+            return sign | 0x7c00 | (magnitude > 0x7f80'0000 ? 0x200 : 0);
+        } else if (magnitude >= 0x477f'f000) {
+            // At least half way between the largest half and 65536
+            return sign | 0x7c00;
+        } else if (magnitude >= 0x3880'0000) {
+            // Normal half: re-bias the exponent and round off 13 bits
+            std::uint32_t const h = magnitude - 0x3800'0000;
+            return sign | ((h + 0xfff + ((h >> 13) & 1)) >> 13);
+        } else if (magnitude > 0x3300'0000) {
+            // Subnormal half, counted in steps of 2^-24
+            std::uint32_t const mantissa = (magnitude & 0x7f'ffff) | 0x80'0000;
+            unsigned const shift = 126 - (magnitude >> 23);
+            return sign
+                    | ((mantissa + (1u << (shift - 1)) - 1
+                        + ((mantissa >> shift) & 1))
+                       >> shift);
+        } else {
+            return sign;
+        }
+    }
+
+
+    namespace detail {
+        /// Used to implement OpenEXR file saving. Do not use directly. The
+        /// channels must be in alphabetical order
+        template<typename C>
+        struct exr_pixel;
+        template<>
+        struct exr_pixel<float> {
+            static constexpr std::array<char, 1> names{'Y'};
+            static std::array<float, 1> get(float const p) { return {p}; }
+        };
+        template<>
+        struct exr_pixel<rgb<float>> {
+            static constexpr std::array<char, 3> names{'B', 'G', 'R'};
+            static std::array<float, 3> get(rgb<float> const &c) {
+                return {c.blue(), c.green(), c.red()};
+            }
+        };
+
+
+        /// Encode the image, passing the bytes to `write` as a
+        /// `std::string_view` a scan line at a time
+        template<typename C, typename E, typename L, typename W>
+        void exr_encode(film<C, E, L> const &image, W &&write) {
+            using pixel = exr_pixel<C>;
+            constexpr std::size_t channels = pixel::names.size();
+            auto const width = narrow<std::int32_t>(image.width());
+            auto const height = narrow<std::int32_t>(image.height());
+
+            std::vector<char> header{0x76, 0x2f, 0x31, 0x01, 2, 0, 0, 0};
+            auto const integer = [&](std::uint64_t v, std::size_t bytes) {
+                for (; bytes; --bytes, v >>= 8) { header.push_back(char(v)); }
+            };
+            auto const attribute = [&](std::string_view const name,
+                                       std::string_view const type,
+                                       std::size_t const size) {
+                header.insert(header.end(), name.begin(), name.end());
+                header.push_back(0);
+                header.insert(header.end(), type.begin(), type.end());
+                header.push_back(0);
+                integer(size, 4);
+            };
+            auto const one = std::bit_cast<std::uint32_t>(1.0f);
+
+            attribute("channels", "chlist", channels * 18 + 1);
+            for (char const name : pixel::names) {
+                header.push_back(name);
+                header.push_back(0);
+                integer(1, 4); // Half
+                integer(0, 4); // Not perceptually linear, then reserved
+                integer(1, 4); // x sampling
+                integer(1, 4); // y sampling
+            }
+            header.push_back(0);
+            attribute("compression", "compression", 1);
+            header.push_back(0); // None
+            for (auto const window : {"dataWindow", "displayWindow"}) {
+                attribute(window, "box2i", 16);
+                integer(0, 4);
+                integer(0, 4);
+                integer(width - 1, 4);
+                integer(height - 1, 4);
+            }
+            attribute("lineOrder", "lineOrder", 1);
+            header.push_back(0); // Increasing y
+            attribute("pixelAspectRatio", "float", 4);
+            integer(one, 4);
+            attribute("screenWindowCenter", "v2f", 8);
+            integer(0, 8);
+            attribute("screenWindowWidth", "float", 4);
+            integer(one, 4);
+            header.push_back(0);
+
+            /// Each line is its y and size followed by the pixels
+            std::size_t const line = 8 + width * channels * 2;
+            std::size_t offset = header.size() + height * 8;
+            for (std::int32_t y{}; y != height; ++y, offset += line) {
+                integer(offset, 8);
+            }
+            write(std::string_view{header.data(), header.size()});
+
+            std::vector<char> row(line);
+            for (std::int32_t y{}; y != height; ++y) {
+                auto const put = [&](std::size_t const at, std::uint32_t v) {
+                    row[at] = char(v);
+                    row[at + 1] = char(v >> 8);
+                    row[at + 2] = char(v >> 16);
+                    row[at + 3] = char(v >> 24);
+                };
+                put(0, y);
+                put(4, line - 8);
+                for (std::int32_t x{}; x != width; ++x) {
+                    auto const values = pixel::get(image.pixel(x, y));
+                    for (std::size_t c{}; c != channels; ++c) {
+                        auto const h = half(values[c]);
+                        auto *const out = row.data() + 8 + (c * width + x) * 2;
+                        out[0] = char(h);
+                        out[1] = char(h >> 8);
+                    }
+                }
+                write(std::string_view{row.data(), row.size()});
+            }
+        }
+    }
+
+
+    /// Encode a film as the bytes of an OpenEXR file
+    template<typename C, typename E, typename L>
+    std::vector<char> exr_bytes(film<C, E, L> const &image) {
+        std::vector<char> bytes;
+        detail::exr_encode(image, [&](std::string_view const b) {
+            bytes.insert(bytes.end(), b.begin(), b.end());
+        });
+        return bytes;
+    }
+
+
+    /// Save a film as an OpenEXR file
+    template<typename C, typename E, typename L>
+    void exr(std::filesystem::path const &filename,
+             film<C, E, L> const &image) {
+        detail::write_file(filename, [&](std::ofstream &file) {
+            detail::exr_encode(image, [&](std::string_view const b) {
+                file.write(b.data(), b.size());
+            });
+        });
+    }
+
+
+}
+
+
+#endif // ANIMRAY_FORMATS_EXR_HPP
@@ -0,0 +1,53 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ANIMRAY_FORMATS_FILE_HPP
+#define ANIMRAY_FORMATS_FILE_HPP
+#pragma once
+
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+
+namespace animray::detail {
+
+
+    /// Used to implement the image savers. Do not use directly. Opens the
+    /// file, passes it to `write` and closes it, throwing if the file
+    /// couldn't be opened or not everything reached it
+    template<typename W>
+    void write_file(std::filesystem::path const &filename, W &&write) {
+        std::ofstream file(filename, std::ios::binary);
+        if (not file) {
+            throw std::runtime_error{"Could not open " + filename.string()};
+        }
+        write(file);
+        file.close();
+        if (not file) {
+            throw std::runtime_error{"Could not write " + filename.string()};
+        }
+    }
+
+
+}
+
+
+#endif // ANIMRAY_FORMATS_FILE_HPP
@@ -0,0 +1,138 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_FORMATS_PFM_HPP
+#define ANIMRAY_FORMATS_PFM_HPP
+#pragma once
+
+
+#include <animray/film.hpp>
+#include <animray/color/rgb.hpp>
+#include <animray/formats/file.hpp>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace animray {
+
+
+    /**
+     * # PFM files
+     *
+     * The Portable Float Map stores every channel as a 32 bit float, so a
+     * film can be saved before it is clamped and tone mapped later on
+     * without rendering it again. `film<rgb<float>>` is written as colour
+     * (`PF`) and `film<float>` as greyscale (`Pf`).
+     *
+     * The rows are stored bottom to top in little endian order. They are
+     * written out one at a time as they are converted, so only a single row
+     * is ever held in memory.
+     */
+
+
+    namespace detail {
+        /// Used to implement PFM file saving. Do not use directly
+        template<typename C>
+        struct pfm_pixel;
+        template<>
+        struct pfm_pixel<float> {
+            static constexpr std::string_view type = "Pf";
+            static constexpr std::size_t channels = 1;
+            static std::array<float, 1> get(float const p) { return {p}; }
+        };
+        template<>
+        struct pfm_pixel<rgb<float>> {
+            static constexpr std::string_view type = "PF";
+            static constexpr std::size_t channels = 3;
+            static std::array<float, 3> get(rgb<float> const &c) {
+                return {c.red(), c.green(), c.blue()};
+            }
+        };
+
+
+        /// Store a float as four little endian bytes
+        inline void little_endian(char *const out, float const f) {
+            auto const bits = std::bit_cast<std::uint32_t>(f);
+            out[0] = char(bits);
+            out[1] = char(bits >> 8);
+            out[2] = char(bits >> 16);
+            out[3] = char(bits >> 24);
+        }
+
+
+        /// Encode the image, passing the bytes to `write` as a
+        /// `std::string_view` a row at a time
+        template<typename C, typename E, typename L, typename W>
+        void pfm_encode(film<C, E, L> const &image, W &&write) {
+            using pixel = pfm_pixel<C>;
+            /// A negative scale marks the data as little endian
+            std::string const header = std::string{pixel::type} + "\n"
+                    + std::to_string(image.width()) + " "
+                    + std::to_string(image.height()) + "\n-1.0\n";
+            write(std::string_view{header});
+
+            std::vector<char> row(image.width() * pixel::channels * 4);
+            for (std::size_t y = image.height(); y--;) {
+                char *out = row.data();
+                for (std::size_t x{}; x != image.width(); ++x) {
+                    for (float const c : pixel::get(image.pixel(x, y))) {
+                        little_endian(out, c);
+                        out += 4;
+                    }
+                }
+                write(std::string_view{row.data(), row.size()});
+            }
+        }
+    }
+
+
+    /// Encode a film as the bytes of a PFM file
+    template<typename C, typename E, typename L>
+    std::vector<char> pfm_bytes(film<C, E, L> const &image) {
+        std::vector<char> bytes;
+        detail::pfm_encode(image, [&](std::string_view const b) {
+            bytes.insert(bytes.end(), b.begin(), b.end());
+        });
+        return bytes;
+    }
+
+
+    /// Save a film as a PFM file
+    template<typename C, typename E, typename L>
+    void pfm(std::filesystem::path const &filename,
+             film<C, E, L> const &image) {
+        detail::write_file(filename, [&](std::ofstream &file) {
+            detail::pfm_encode(image, [&](std::string_view const b) {
+                file.write(b.data(), b.size());
+            });
+        });
+    }
+
+
+}
+
+
+#endif // ANIMRAY_FORMATS_PFM_HPP
@@ -0,0 +1,276 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_FORMATS_PNG_HPP
+#define ANIMRAY_FORMATS_PNG_HPP
+#pragma once
+
+
+#include <animray/film.hpp>
+#include <animray/color/luma.hpp>
+#include <animray/color/rgb.hpp>
+#include <animray/formats/deflate.hpp>
+#include <animray/formats/file.hpp>
+#include <animray/narrow.hpp>
+#include <animray/threading/pool.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <string_view>
+#include <vector>
+
+
+namespace animray {
+
+
+    /**
+     * # PNG files
+     *
+     * Each row is given whichever of the five PNG filters leaves the
+     * smallest sum of absolute differences, and the filtered rows are
+     * compressed with `deflate::compress`.
+     *
+     * The rows are cut into strips of `png_strip_rows` which are filtered
+     * and compressed separately. When a `threading::pool` is given the
+     * strips are compressed as jobs on it, so a frame can be compressed on
+     * the render threads. The image data is written as a single `IDAT`
+     * chunk.
+     */
+    constexpr std::size_t png_strip_rows = 32;
+
+
+    namespace detail {
+        /// Used to implement PNG file saving. Do not use directly
+        template<typename C>
+        struct png_pixel;
+        template<>
+        struct png_pixel<uint8_t> {
+            static constexpr std::uint8_t colour_type = 0; // Greyscale
+            static constexpr std::size_t bytes = 1;
+            static void put(std::uint8_t *const out, uint8_t const p) {
+                *out = p;
+            }
+        };
+        template<>
+        struct png_pixel<luma<>> {
+            static constexpr std::uint8_t colour_type = 0; // Greyscale
+            static constexpr std::size_t bytes = 1;
+            static void put(std::uint8_t *const out, luma<> const p) {
+                *out = uint8_t(p);
+            }
+        };
+        template<>
+        struct png_pixel<rgb<uint8_t>> {
+            static constexpr std::uint8_t colour_type = 2; // Truecolour
+            static constexpr std::size_t bytes = 3;
+            static void put(std::uint8_t *const out, rgb<uint8_t> const &c) {
+                out[0] = c.red();
+                out[1] = c.green();
+                out[2] = c.blue();
+            }
+        };
+
+
+        /// A strip of rows once it is compressed
+        struct png_strip {
+            std::vector<std::uint8_t> deflated;
+            std::uint32_t adler;
+            std::size_t length;
+        };
+
+
+        /// The Paeth predictor from the PNG specification
+        inline std::uint8_t
+                paeth(int const a, int const b, int const c) noexcept {
+            int const p = a + b - c;
+            int const pa = std::abs(p - a), pb = std::abs(p - b),
+                      pc = std::abs(p - c);
+            if (pa <= pb and pa <= pc) {
+                return a;
+            } else if (pb <= pc) {
+                return b;
+            } else {
+                return c;
+            }
+        }
+
+
+        /// Filter and compress the rows from `top` up to (not including)
+        /// `end`
+        template<typename C, typename E, typename L>
+        png_strip png_compress(
+                film<C, E, L> const &image,
+                std::size_t const top,
+                std::size_t const end) {
+            using pixel = png_pixel<C>;
+            constexpr std::size_t bpp = pixel::bytes;
+            std::size_t const stride = image.width() * bpp;
+            std::vector<std::uint8_t> above(stride), row(stride),
+                    filtered((end - top) * (stride + 1)), candidate(stride);
+            auto const fetch = [&](std::vector<std::uint8_t> &into,
+                                   std::size_t const y) {
+                for (std::size_t x{}; x != image.width(); ++x) {
+                    pixel::put(into.data() + x * bpp, image.pixel(x, y));
+                }
+            };
+            if (top) { fetch(above, top - 1); }
+            for (std::size_t y = top; y != end; ++y) {
+                fetch(row, y);
+                auto *const out = filtered.data() + (y - top) * (stride + 1);
+                std::size_t best_cost = ~std::size_t{};
+                for (std::uint8_t filter{}; filter != 5; ++filter) {
+                    std::size_t cost{};
+                    for (std::size_t i{}; i != stride; ++i) {
+                        int const a = i >= bpp ? row[i - bpp] : 0,
+                                  b = above[i],
+                                  c = i >= bpp ? above[i - bpp] : 0;
+                        std::uint8_t predicted{};
+                        switch (filter) {
+                        case 1: predicted = a; break;
+                        case 2: predicted = b; break;
+                        case 3: predicted = (a + b) / 2; break;
+                        case 4: predicted = paeth(a, b, c); break;
+                        }
+                        candidate[i] = row[i] - predicted;
+                        cost += std::abs(int(std::int8_t(candidate[i])));
+                    }
+                    if (cost < best_cost) {
+                        best_cost = cost;
+                        out[0] = filter;
+                        std::copy(candidate.begin(), candidate.end(), out + 1);
+                    }
+                }
+                std::swap(above, row);
+            }
+            png_strip strip{{}, deflate::adler32(filtered), filtered.size()};
+            deflate::compress(filtered, end == image.height(), strip.deflated);
+            return strip;
+        }
+
+
+        /// Append a chunk
+        inline void png_chunk(
+                std::vector<std::uint8_t> &out,
+                std::string_view const type,
+                std::span<std::uint8_t const> const data) {
+            auto const big_endian = [&](std::uint32_t const v) {
+                for (int shift = 24; shift >= 0; shift -= 8) {
+                    out.push_back(std::uint8_t(v >> shift));
+                }
+            };
+            big_endian(narrow<std::uint32_t>(data.size()));
+            std::size_t const start = out.size();
+            out.insert(out.end(), type.begin(), type.end());
+            out.insert(out.end(), data.begin(), data.end());
+            big_endian(deflate::crc32(
+                    {out.data() + start, out.size() - start}));
+        }
+    }
+
+
+    /// Encode a film as the bytes of a PNG file, compressing the strips on
+    /// the pool if one is given
+    template<typename C, typename E, typename L>
+    std::vector<std::uint8_t> png_bytes(
+            film<C, E, L> const &image, threading::pool *const workers = {}) {
+        std::size_t const height = image.height();
+        std::vector<detail::png_strip> strips;
+        if (workers) {
+            std::vector<std::future<detail::png_strip>> jobs;
+            for (std::size_t top{}; top < height; top += png_strip_rows) {
+                jobs.push_back(workers->submit([&image, top, height]() {
+                    return detail::png_compress(
+                            image, top, std::min(height, top + png_strip_rows));
+                }));
+            }
+            for (auto &job : jobs) {
+                strips.push_back(workers->wait(std::move(job)));
+            }
+        } else {
+            for (std::size_t top{}; top < height; top += png_strip_rows) {
+                strips.push_back(detail::png_compress(
+                        image, top, std::min(height, top + png_strip_rows)));
+            }
+        }
+
+        std::vector<std::uint8_t> zlib{0x78, 0x01};
+        std::uint32_t adler = 1;
+        for (auto const &strip : strips) {
+            zlib.insert(
+                    zlib.end(), strip.deflated.begin(), strip.deflated.end());
+            adler = deflate::adler32_combine(adler, strip.adler, strip.length);
+        }
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            zlib.push_back(std::uint8_t(adler >> shift));
+        }
+
+        auto const w = narrow<std::uint32_t>(image.width());
+        auto const h = narrow<std::uint32_t>(height);
+        std::array<std::uint8_t, 13> const header{
+                std::uint8_t(w >> 24), std::uint8_t(w >> 16),
+                std::uint8_t(w >> 8), std::uint8_t(w),
+                std::uint8_t(h >> 24), std::uint8_t(h >> 16),
+                std::uint8_t(h >> 8), std::uint8_t(h),
+                8, // Bit depth
+                detail::png_pixel<C>::colour_type,
+                0, // Deflate
+                0, // Adaptive filtering
+                0 // Not interlaced
+        };
+        std::vector<std::uint8_t> bytes{0x89, 'P', 'N', 'G', '\r', '\n', 0x1a,
+                                        '\n'};
+        detail::png_chunk(bytes, "IHDR", header);
+        detail::png_chunk(bytes, "IDAT", zlib);
+        detail::png_chunk(bytes, "IEND", {});
+        return bytes;
+    }
+
+
+    /// Save a film as a PNG file
+    template<typename C, typename E, typename L>
+    void png(std::filesystem::path const &filename,
+             film<C, E, L> const &image) {
+        auto const bytes = png_bytes(image);
+        detail::write_file(filename, [&](std::ofstream &file) {
+            file.write(
+                    reinterpret_cast<char const *>(bytes.data()),
+                    bytes.size());
+        });
+    }
+    /// Save a film as a PNG file, compressing it on the pool
+    template<typename C, typename E, typename L>
+    void png(std::filesystem::path const &filename,
+             film<C, E, L> const &image,
+             threading::pool &workers) {
+        auto const bytes = png_bytes(image, &workers);
+        detail::write_file(filename, [&](std::ofstream &file) {
+            file.write(
+                    reinterpret_cast<char const *>(bytes.data()),
+                    bytes.size());
+        });
+    }
+
+
+}
+
+
+#endif // ANIMRAY_FORMATS_PNG_HPP
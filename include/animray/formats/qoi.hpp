@@ -0,0 +1,165 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_FORMATS_QOI_HPP
+#define ANIMRAY_FORMATS_QOI_HPP
+#pragma once
+
+
+#include <animray/film.hpp>
+#include <animray/color/luma.hpp>
+#include <animray/color/rgb.hpp>
+#include <animray/formats/file.hpp>
+#include <animray/narrow.hpp>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+
+namespace animray {
+
+
+    /**
+     * # QOI files
+     *
+     * The "Quite OK Image" format codes each pixel as a run of the last
+     * pixel, a reference into a table of recently seen pixels, a small
+     * difference from the last pixel, or the pixel itself. It compresses
+     * rendered frames nearly as well as PNG at a fraction of the cost.
+     *
+     * Films are always written with three channels, so greyscale films are
+     * expanded to RGB.
+     */
+
+
+    namespace detail {
+        /// Used to implement QOI file saving. Do not use directly
+        template<typename C>
+        struct qoi_pixel;
+        template<>
+        struct qoi_pixel<uint8_t> {
+            static std::array<std::uint8_t, 3> get(uint8_t const p) {
+                return {p, p, p};
+            }
+        };
+        template<>
+        struct qoi_pixel<luma<>> {
+            static std::array<std::uint8_t, 3> get(luma<> const p) {
+                return {uint8_t(p), uint8_t(p), uint8_t(p)};
+            }
+        };
+        template<>
+        struct qoi_pixel<rgb<uint8_t>> {
+            static std::array<std::uint8_t, 3> get(rgb<uint8_t> const &c) {
+                return {c.red(), c.green(), c.blue()};
+            }
+        };
+    }
+
+
+    /// Encode a film as the bytes of a QOI file
+    template<typename C, typename E, typename L>
+    std::vector<std::uint8_t> qoi_bytes(film<C, E, L> const &image) {
+        std::vector<std::uint8_t> out;
+        out.reserve(14 + image.width() * image.height() + 8);
+        auto const big_endian = [&](std::uint32_t const v) {
+            for (int shift = 24; shift >= 0; shift -= 8) {
+                out.push_back(std::uint8_t(v >> shift));
+            }
+        };
+        for (char const c : {'q', 'o', 'i', 'f'}) { out.push_back(c); }
+        big_endian(narrow<std::uint32_t>(image.width()));
+        big_endian(narrow<std::uint32_t>(image.height()));
+        out.push_back(3); // RGB
+        out.push_back(0); // sRGB with linear alpha
+
+        /**
+         * The index holds RGBA, starting as transparent black like the
+         * decoder's, so an entry that was never written can't match one of
+         * our pixels, whose alpha is always 255.
+         */
+        std::array<std::array<std::uint8_t, 4>, 64> seen{};
+        std::array<std::uint8_t, 3> last{0, 0, 0};
+        std::size_t run{};
+        image.for_each_row([&](C const &colour) {
+            auto const p = detail::qoi_pixel<C>::get(colour);
+            if (p == last) {
+                if (++run == 62) {
+                    out.push_back(0xc0 | (run - 1));
+                    run = 0;
+                }
+                return;
+            }
+            if (run) {
+                out.push_back(0xc0 | (run - 1));
+                run = 0;
+            }
+            std::size_t const hash =
+                    (p[0] * 3 + p[1] * 5 + p[2] * 7 + 255 * 11) % 64;
+            std::array<std::uint8_t, 4> const rgba{p[0], p[1], p[2], 255};
+            if (seen[hash] == rgba) {
+                out.push_back(hash);
+            } else {
+                seen[hash] = rgba;
+                int const dr = std::int8_t(p[0] - last[0]),
+                          dg = std::int8_t(p[1] - last[1]),
+                          db = std::int8_t(p[2] - last[2]);
+                int const dr_dg = dr - dg, db_dg = db - dg;
+                if (dr >= -2 and dr <= 1 and dg >= -2 and dg <= 1 and db >= -2
+                    and db <= 1) {
+                    out.push_back(
+                            0x40 | ((dr + 2) << 4) | ((dg + 2) << 2)
+                            | (db + 2));
+                } else if (
+                        dg >= -32 and dg <= 31 and dr_dg >= -8 and dr_dg <= 7
+                        and db_dg >= -8 and db_dg <= 7) {
+                    out.push_back(0x80 | (dg + 32));
+                    out.push_back(((dr_dg + 8) << 4) | (db_dg + 8));
+                } else {
+                    out.insert(out.end(), {0xfe, p[0], p[1], p[2]});
+                }
+            }
+            last = p;
+        });
+        if (run) { out.push_back(0xc0 | (run - 1)); }
+        out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+        return out;
+    }
+
+
+    /// Save a film as a QOI file
+    template<typename C, typename E, typename L>
+    void qoi(std::filesystem::path const &filename,
+             film<C, E, L> const &image) {
+        auto const bytes = qoi_bytes(image);
+        detail::write_file(filename, [&](std::ofstream &file) {
+            file.write(
+                    reinterpret_cast<char const *>(bytes.data()),
+                    bytes.size());
+        });
+    }
+
+
+}
+
+
+#endif // ANIMRAY_FORMATS_QOI_HPP
@@ -0,0 +1,86 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_FORMATS_SAVE_HPP
+#define ANIMRAY_FORMATS_SAVE_HPP
+#pragma once
+
+
+#include <animray/formats/exr.hpp>
+#include <animray/formats/pfm.hpp>
+#include <animray/formats/png.hpp>
+#include <animray/formats/qoi.hpp>
+#include <animray/formats/targa.hpp>
+
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace animray {
+
+
+    /// Save a film in the format given by the file name's extension, which
+    /// must be one of `.png`, `.qoi` or `.tga`. Any other extension throws
+    /// `std::invalid_argument` rather than writing a file whose name says
+    /// it is something else. PNG files are compressed on the pool when one
+    /// is given.
+    ///
+    /// Films of `float` or `rgb<float>` keep their full range, so they can
+    /// only be saved as `.exr` or `.pfm`.
+    template<typename C, typename E, typename L>
+    void save(
+            std::filesystem::path const &filename,
+            film<C, E, L> const &image,
+            threading::pool *const workers = {}) {
+        auto const extension = filename.extension();
+        if constexpr (
+                std::is_same_v<C, float> or std::is_same_v<C, rgb<float>>) {
+            if (extension == ".exr") {
+                exr(filename, image);
+            } else if (extension == ".pfm") {
+                pfm(filename, image);
+            } else {
+                throw std::invalid_argument{
+                        "Floating point images are saved as .exr or .pfm, "
+                        "not "
+                        + filename.string()};
+            }
+        } else if (extension == ".png") {
+            if (workers) {
+                png(filename, image, *workers);
+            } else {
+                png(filename, image);
+            }
+        } else if (extension == ".qoi") {
+            qoi(filename, image);
+        } else if (extension == ".tga") {
+            targa(filename, image);
+        } else {
+            throw std::invalid_argument{
+                    "Images are saved as .png, .qoi or .tga, not "
+                    + filename.string()};
+        }
+    }
+
+
+}
+
+
+#endif // ANIMRAY_FORMATS_SAVE_HPP
@@ -26,98 +26,198 @@
 #include <animray/film.hpp>
 #include <animray/color/luma.hpp>
 #include <animray/color/rgb.hpp>
+#include <animray/formats/file.hpp>
 #include <animray/narrow.hpp>
+#include <array>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <string_view>
+#include <vector>
 
 
 namespace animray {
 
 
+    /**
+     * # Targa files
+     *
+     * Films are encoded a row at a time into a buffer, and each finished
+     * row is passed on with a single write. The header fields are written
+     * as little-endian whatever the host's byte order.
+     *
+     * Run length encoding (Targa types 10 and 11) can be asked for. Each row
+     * is encoded separately as the format recommends, as packets of up to
+     * 128 repeated or 128 literal pixels. Frames with large areas of plain
+     * background shrink a lot.
+     */
+    enum class targa_encoding { raw, rle };
+
+
     namespace detail {
         /// Used to implement the Targa file saving. Do not use directly
-        template<typename C, typename E>
+        template<typename C>
         struct targa_saver;
+
+
+        /// Run length encode a row of pixels of `B` bytes each. Returns
+        /// the number of bytes written to `out`
+        template<std::size_t B>
+        std::size_t targa_rle_row(
+                std::vector<char> const &pixels, std::vector<char> &out) {
+            std::size_t const count = pixels.size() / B;
+            auto const same = [&](std::size_t const l, std::size_t const r) {
+                return std::equal(
+                        pixels.begin() + l * B, pixels.begin() + l * B + B,
+                        pixels.begin() + r * B);
+            };
+            std::size_t written{}, index{};
+            while (index < count) {
+                std::size_t run = 1;
+                while (index + run < count and run < 128
+                       and same(index, index + run)) {
+                    ++run;
+                }
+                if (run > 1) {
+                    out[written++] = char(0x80 | (run - 1));
+                    std::copy_n(
+                            pixels.begin() + index * B, B,
+                            out.begin() + written);
+                    written += B;
+                    index += run;
+                } else {
+                    /// Literal pixels go up to the start of the next run
+                    std::size_t literal = 1;
+                    while (index + literal < count and literal < 128
+                           and (index + literal + 1 == count
+                                or not same(
+                                        index + literal,
+                                        index + literal + 1))) {
+                        ++literal;
+                    }
+                    out[written++] = char(literal - 1);
+                    std::copy_n(
+                            pixels.begin() + index * B, literal * B,
+                            out.begin() + written);
+                    written += literal * B;
+                    index += literal;
+                }
+            }
+            return written;
+        }
+
+
+        /// Encode the image, passing the bytes to `write` as a
+        /// `std::string_view` a block at a time
+        template<typename C, typename E, typename L, typename W>
+        void targa_encode(
+                film<C, E, L> const &image,
+                targa_encoding const encoding,
+                W &&write) {
+            using saver = targa_saver<C>;
+            constexpr std::size_t bytes = saver::bytes;
+            bool const rle = (encoding == targa_encoding::rle);
+            auto const w = narrow<std::uint16_t>(image.width());
+            auto const h = narrow<std::uint16_t>(image.height());
+            std::array<char, 18> const header{
+                    0, // identsize
+                    0, // Has no colour map
+                    char(saver::type + (rle ? 8 : 0)),
+                    0, 0, // Colour map offset
+                    0, 0, // Colour map indexes
+                    0, // Colour map bits per pixel
+                    0, 0, // X origin
+                    0, 0, // Y origin
+                    char(w & 0xff), char(w >> 8), char(h & 0xff),
+                    char(h >> 8),
+                    char(bytes * 8), // n bit pixels
+                    0x20 // Image data starts top left with zero alpha
+            };
+            write(std::string_view{header.data(), header.size()});
+
+            /// The pixels of one row, and the row as it is written. Every
+            /// packet holds at least one pixel, so an encoded row never
+            /// needs more than one extra byte per pixel
+            std::vector<char> pixels(w * bytes),
+                    row(rle ? pixels.size() + w : 0);
+            std::size_t column{};
+            image.for_each_row([&](C const &p) {
+                saver::put(pixels.data() + column * bytes, p);
+                if (++column == w) {
+                    column = 0;
+                    if (rle) {
+                        std::size_t const size =
+                                targa_rle_row<bytes>(pixels, row);
+                        write(std::string_view{row.data(), size});
+                    } else {
+                        write(std::string_view{pixels.data(), pixels.size()});
+                    }
+                }
+            });
+
+            // Footer (for Targa 2)
+            constexpr std::string_view footer{
+                    "\0\0\0\0\0\0\0\0TRUEVISION-XFILE.\0", 26};
+            write(footer);
+        }
+    }
+
+
+    /// Encode a film as the bytes of a Targa file
+    template<typename C, typename E, typename L>
+    std::vector<char> targa_bytes(
+            film<C, E, L> const &image,
+            targa_encoding const encoding = targa_encoding::raw) {
+        std::vector<char> bytes;
+        detail::targa_encode(image, encoding, [&](std::string_view const b) {
+            bytes.insert(bytes.end(), b.begin(), b.end());
+        });
+        return bytes;
     }
 
 
     /// Save a film as a Targa file
-    template<typename C, typename E>
-    void targa(std::filesystem::path const &filename, const film<C, E> &image) {
-        detail::targa_saver<C, E> saver;
-        std::ofstream file(filename, std::ios::binary);
-        // Header
-        file.put(0); // 0 identsize
-        file.put(0); // Has no colour map
-        file.put(saver.type);
-        file.put(0);
-        file.put(0); // Colour map offset
-        file.put(0);
-        file.put(0); // Colour map indexes
-        file.put(0); // Colour map bits per pixel
-        file.put(0);
-        file.put(0); // X origin
-        file.put(0);
-        file.put(0); // Y origin
-        uint16_t w(narrow<uint16_t>(image.width()));
-        uint16_t h(narrow<uint16_t>(image.height()));
-        /// TODO Don'l rely on endian mode we're running in
-        file.write(reinterpret_cast<const char *>(&w), 2);
-        file.write(reinterpret_cast<const char *>(&h), 2);
-        file.put(saver.bits); // n bit pixels
-        file.put(0x20); // Image data starts top left with zero alpha channel
-        // Image data
-        saver(file, image);
-        // Footer (for Targa 2)
-        file.put(0);
-        file.put(0); // Targa 2 extension data size
-        file << "TRUEVISION-XFILE.";
-        file.put(0);
+    template<typename C, typename E, typename L>
+    void targa(
+            std::filesystem::path const &filename,
+            film<C, E, L> const &image,
+            targa_encoding const encoding = targa_encoding::raw) {
+        detail::write_file(filename, [&](std::ofstream &file) {
+            detail::targa_encode(
+                    image, encoding, [&](std::string_view const b) {
+                        file.write(b.data(), b.size());
+                    });
+        });
     }
 
 
     namespace detail {
         /// Save 8 bit films as Targa file
-        template<typename E>
-        struct targa_saver<uint8_t, E> {
-            const static char type = 3; // Uncompressed grayscale image
-            const static uint8_t bits = 8;
-            void operator()(
-                    std::ostream &file, const film<uint8_t, E> &image) const {
-                typedef typename film<uint8_t, E>::size_type size_type;
-                for (size_type r = 0; r < image.height(); ++r)
-                    for (size_type c = 0; c < image.width(); ++c)
-                        file.put(image[c][r]);
-            }
+        template<>
+        struct targa_saver<uint8_t> {
+            static constexpr char type = 3; // Uncompressed grayscale image
+            static constexpr std::size_t bytes = 1;
+            static void put(char *const out, uint8_t const p) { *out = p; }
         };
-        template<typename E>
-        struct targa_saver<luma<>, E> {
-            const static char type = 3; // Uncompressed grayscale image
-            const static uint8_t bits = 8;
-            void operator()(
-                    std::ostream &file, const film<luma<>, E> &image) const {
-                using size_type = typename film<luma<>, E>::size_type;
-                for (size_type r = 0; r < image.height(); ++r)
-                    for (size_type c = 0; c < image.width(); ++c)
-                        file.put(image[c][r]);
+        template<>
+        struct targa_saver<luma<>> {
+            static constexpr char type = 3; // Uncompressed grayscale image
+            static constexpr std::size_t bytes = 1;
+            static void put(char *const out, luma<> const p) {
+                *out = uint8_t(p);
             }
         };
 
-        /// Save 24 bit RGB films as Targa file
-        template<typename E>
-        struct targa_saver<rgb<uint8_t>, E> {
-            const static char type = 2; // Uncompressed RGB image
-            const static uint8_t bits = 24;
-            void operator()(
-                    std::ostream &file, const film<rgb<uint8_t>, E> &image) {
-                using size_type = typename film<rgb<uint8_t>, E>::size_type;
-                for (size_type r = 0; r < image.height(); ++r)
-                    for (size_type c = 0; c < image.width(); ++c) {
-                        rgb<uint8_t> col(image[c][r]);
-                        file.put(col.blue());
-                        file.put(col.green());
-                        file.put(col.red());
-                    }
+        /// Save 24 bit RGB films as Targa file. The channels are stored
+        /// blue first
+        template<>
+        struct targa_saver<rgb<uint8_t>> {
+            static constexpr char type = 2; // Uncompressed RGB image
+            static constexpr std::size_t bytes = 3;
+            static void put(char *const out, rgb<uint8_t> const &col) {
+                out[0] = col.blue();
+                out[1] = col.green();
+                out[2] = col.red();
             }
         };
     }
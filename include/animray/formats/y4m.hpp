@@ -0,0 +1,299 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_FORMATS_Y4M_HPP
+#define ANIMRAY_FORMATS_Y4M_HPP
+#pragma once
+
+
+#include <animray/film.hpp>
+#include <animray/color/luma.hpp>
+#include <animray/color/rgb.hpp>
+#include <animray/color/yuv.hpp>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace animray {
+
+
+    /**
+     * # YUV4MPEG2 video
+     *
+     * Writes a whole sequence of frames to a single stream that video
+     * encoders read directly, for example `ffmpeg -i sequence.y4m`. The
+     * path may also be a named pipe, in which case the frames go straight
+     * into the encoder without ever being stored.
+     *
+     * Frames are stored as studio range BT.709 Y'CbCr with 4:2:0 chroma,
+     * using the same weights as `yuv<>`. The luma is scaled to 219 levels
+     * and the `u` and `v` ranges of `yuv<>` to 224 levels. Each chroma
+     * sample is taken from the average of a 2x2 block of pixels.
+     *
+     * The conversion works on whole rows split into separate red, green
+     * and blue arrays using integer arithmetic, so that the compiler can
+     * vectorise the loops.
+     */
+
+
+    namespace detail {
+        /// Used to implement Y4M saving. Do not use directly
+        template<typename C>
+        struct y4m_pixel;
+        template<>
+        struct y4m_pixel<uint8_t> {
+            static std::array<std::uint8_t, 3> get(uint8_t const p) {
+                return {p, p, p};
+            }
+        };
+        template<>
+        struct y4m_pixel<luma<>> {
+            static std::array<std::uint8_t, 3> get(luma<> const p) {
+                return {uint8_t(p), uint8_t(p), uint8_t(p)};
+            }
+        };
+        template<>
+        struct y4m_pixel<rgb<uint8_t>> {
+            static std::array<std::uint8_t, 3> get(rgb<uint8_t> const &c) {
+                return {c.red(), c.green(), c.blue()};
+            }
+        };
+
+
+        /// Round to the nearest integer at compile time
+        constexpr std::int32_t y4m_round(double const v) {
+            return std::int32_t(v < 0 ? v - 0.5 : v + 0.5);
+        }
+        /// Turn weights that go from 8 bit RGB to `scale` levels into 8.8
+        /// fixed point. The weight at `own` is chosen so that the weights
+        /// add up to zero, which means grey has no colour
+        constexpr std::array<std::int32_t, 3> y4m_chroma_weights(
+                std::array<double, 3> const weights,
+                double const scale,
+                std::size_t const own) {
+            std::array<std::int32_t, 3> fixed{};
+            for (std::size_t c{}; c != 3; ++c) {
+                if (c != own) {
+                    fixed[c] = y4m_round(weights[c] * scale * 256 / 255);
+                    fixed[own] -= fixed[c];
+                }
+            }
+            return fixed;
+        }
+
+
+        /// The `yuv<>` weights in 8.8 fixed point, scaled to the studio
+        /// ranges. Blue gives the largest `u` and red the largest `v`, and
+        /// those go to 112 levels from the centre
+        struct y4m_weights : yuv_weights {
+            static constexpr double luma = 219.0 * 256 / 255;
+            static constexpr std::array<std::int32_t, 3> y{
+                    y4m_round(red * luma), y4m_round(green * luma),
+                    y4m_round(blue * luma)};
+            static constexpr std::array<std::int32_t, 3> cb =
+                    y4m_chroma_weights(
+                            {-red / u, -green / u, (1 - blue) / u},
+                            112 * u / (1 - blue), 2);
+            static constexpr std::array<std::int32_t, 3> cr =
+                    y4m_chroma_weights(
+                            {(1 - red) / v, -green / v, -blue / v},
+                            112 * v / (1 - red), 0);
+        };
+        constexpr auto y4m_y = y4m_weights::y, y4m_cb = y4m_weights::cb,
+                       y4m_cr = y4m_weights::cr;
+
+
+        /// A row of pixels as separate channels. The row is padded to an
+        /// even width by repeating the last pixel
+        struct y4m_row {
+            std::vector<std::int32_t> r, g, b;
+
+            explicit y4m_row(std::size_t const width)
+            : r(width + width % 2), g(r.size()), b(r.size()) {}
+
+            template<typename C, typename E, typename L>
+            void fetch(film<C, E, L> const &image, std::size_t const y) {
+                std::size_t const width = image.width();
+                for (std::size_t x{}; x != width; ++x) {
+                    auto const p = y4m_pixel<C>::get(image.pixel(x, y));
+                    r[x] = p[0];
+                    g[x] = p[1];
+                    b[x] = p[2];
+                }
+                if (width % 2) {
+                    r[width] = r[width - 1];
+                    g[width] = g[width - 1];
+                    b[width] = b[width - 1];
+                }
+            }
+
+            /// Add another row to this one. Each channel is added by a loop
+            /// of its own, which keeps the number of arrays that might
+            /// alias low enough for the compiler to vectorise the loops
+            void add(y4m_row const &row) {
+                auto const sum = [](std::vector<std::int32_t> &into,
+                                    std::vector<std::int32_t> const &from) {
+                    std::int32_t *const i = into.data();
+                    std::int32_t const *const f = from.data();
+                    for (std::size_t x{}; x != into.size(); ++x) {
+                        i[x] += f[x];
+                    }
+                };
+                sum(r, row.r);
+                sum(g, row.g);
+                sum(b, row.b);
+            }
+        };
+
+
+        /// Convert a row to luma
+        inline void y4m_luma(
+                y4m_row const &row,
+                std::size_t const width,
+                std::uint8_t *const out) {
+            std::int32_t const *const r = row.r.data();
+            std::int32_t const *const g = row.g.data();
+            std::int32_t const *const b = row.b.data();
+            for (std::size_t x{}; x != width; ++x) {
+                out[x] = std::uint8_t(
+                        16
+                        + ((y4m_y[0] * r[x] + y4m_y[1] * g[x]
+                            + y4m_y[2] * b[x] + 128)
+                           >> 8));
+            }
+        }
+
+
+        /// Convert a pair of rows that have been added together to one row
+        /// of each chroma channel
+        inline void y4m_chroma(
+                y4m_row const &pair,
+                std::uint8_t *const cb,
+                std::uint8_t *const cr) {
+            std::size_t const width = pair.r.size() / 2;
+            std::int32_t const *const rs = pair.r.data();
+            std::int32_t const *const gs = pair.g.data();
+            std::int32_t const *const bs = pair.b.data();
+            for (std::size_t x{}; x != width; ++x) {
+                std::int32_t const r = rs[2 * x] + rs[2 * x + 1];
+                std::int32_t const g = gs[2 * x] + gs[2 * x + 1];
+                std::int32_t const b = bs[2 * x] + bs[2 * x + 1];
+                cb[x] = std::uint8_t(
+                        128
+                        + ((y4m_cb[0] * r + y4m_cb[1] * g + y4m_cb[2] * b
+                            + 512)
+                           >> 10));
+                cr[x] = std::uint8_t(
+                        128
+                        + ((y4m_cr[0] * r + y4m_cr[1] * g + y4m_cr[2] * b
+                            + 512)
+                           >> 10));
+            }
+        }
+    }
+
+
+    /// Writes frames one after the other to a YUV4MPEG2 stream. The first
+    /// frame sets the size, and every frame after it must be the same size
+    class y4m_stream {
+        std::ofstream file;
+        std::ostream &out;
+        std::size_t const frame_rate;
+        std::size_t width{}, height{};
+        std::vector<std::uint8_t> planes;
+
+      public:
+        /// Write to a file or named pipe
+        explicit y4m_stream(
+                std::filesystem::path const &filename,
+                std::size_t const fps = 25)
+        : file{filename, std::ios::binary}, out{file}, frame_rate{fps} {
+            if (not file) {
+                throw std::runtime_error{
+                        "Could not open " + filename.string()};
+            }
+        }
+        /// Write to a stream that is already open
+        explicit y4m_stream(std::ostream &o, std::size_t const fps = 25)
+        : out{o}, frame_rate{fps} {}
+
+        /// True for the films whose frames can be written
+        template<typename F>
+        static constexpr bool accepts = requires {
+            detail::y4m_pixel<typename F::color_type>::get;
+        };
+
+        y4m_stream(y4m_stream const &) = delete;
+        y4m_stream &operator=(y4m_stream const &) = delete;
+
+        /// Convert a frame and write it out
+        template<typename C, typename E, typename L>
+        void frame(film<C, E, L> const &image) {
+            if (planes.empty()) {
+                width = image.width();
+                height = image.height();
+                out << "YUV4MPEG2 W" << width << " H" << height << " F"
+                    << frame_rate << ":1 Ip A1:1 C420jpeg XYSCSS=420JPEG"
+                    << " XCOLORRANGE=LIMITED\n";
+                planes.resize(
+                        width * height
+                        + 2 * ((width + 1) / 2) * ((height + 1) / 2));
+            } else if (image.width() != width or image.height() != height) {
+                throw std::invalid_argument{
+                        "Every frame of a Y4M stream must be the same size"};
+            }
+            std::size_t const chroma_width = (width + 1) / 2;
+            std::uint8_t *const luma = planes.data();
+            std::uint8_t *const cb = luma + width * height;
+            std::uint8_t *const cr = cb + chroma_width * ((height + 1) / 2);
+
+            detail::y4m_row top{width}, bottom{width};
+            for (std::size_t y{}; y < height; y += 2) {
+                top.fetch(image, y);
+                detail::y4m_luma(top, width, luma + y * width);
+                /// An odd last row is paired with itself
+                if (y + 1 < height) {
+                    bottom.fetch(image, y + 1);
+                    detail::y4m_luma(bottom, width, luma + (y + 1) * width);
+                    top.add(bottom);
+                } else {
+                    top.add(top);
+                }
+                std::size_t const offset = y / 2 * chroma_width;
+                detail::y4m_chroma(top, cb + offset, cr + offset);
+            }
+            out << "FRAME\n";
+            out.write(reinterpret_cast<char const *>(planes.data()),
+                      planes.size());
+            out.flush();
+        }
+    };
+
+
+}
+
+
+#endif // ANIMRAY_FORMATS_Y4M_HPP
@@ -0,0 +1,248 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_GEOMETRY_BOUNDING_BOX_HPP
+#define ANIMRAY_GEOMETRY_BOUNDING_BOX_HPP
+#pragma once
+
+
+#include <animray/affine-matrix.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+
+namespace animray {
+
+
+    /**
+     * # Bounding box
+     *
+     * An axis aligned box in the local co-ordinate space of some geometry.
+     * Geometry that can be placed in an acceleration structure exposes a
+     * `bounds()` member returning one of these. Unbounded geometry (planes)
+     * uses infinite extents.
+     */
+
+
+    /// The ray in the form needed for slab tests against bounding boxes
+    template<typename D>
+    struct bounding_ray {
+        /// The start of the ray
+        std::array<D, 3> from;
+        /// The reciprocal of the direction components
+        std::array<D, 3> inverse_direction;
+
+        /// Construct from any ray type
+        template<typename R>
+        explicit bounding_ray(R const &by)
+        : from{by.from.x(), by.from.y(), by.from.z()},
+          inverse_direction{
+                  D{1} / by.direction.x(), D{1} / by.direction.y(),
+                  D{1} / by.direction.z()} {}
+    };
+
+
+    /// Axis aligned bounding box
+    template<typename D>
+    struct bounding_box {
+        /// The type of the local coordinates used
+        using local_coord_type = D;
+        /// The type used to store each of the corners
+        using corner_type = std::array<D, 3>;
+
+        /// The corner with the smallest coordinates
+        corner_type lower{infinity, infinity, infinity};
+        /// The corner with the largest coordinates
+        corner_type upper{-infinity, -infinity, -infinity};
+
+        /// Construct an empty box
+        constexpr bounding_box() = default;
+        /// Construct a box from its corners
+        constexpr bounding_box(corner_type l, corner_type u)
+        : lower{l}, upper{u} {}
+
+        /// A box that contains all of space
+        static constexpr bounding_box everything() {
+            return {{-infinity, -infinity, -infinity},
+                    {infinity, infinity, infinity}};
+        }
+
+        /// True if nothing has been added to the box
+        bool empty() const {
+            return lower[0] > upper[0] or lower[1] > upper[1]
+                    or lower[2] > upper[2];
+        }
+        /// True if the box has finite extents
+        bool is_finite() const {
+            for (std::size_t axis{}; axis < 3; ++axis) {
+                if (not std::isfinite(lower[axis])
+                    or not std::isfinite(upper[axis])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// Grow the box so that it includes a point
+        bounding_box &merge(point3d<D> const &p) {
+            return merge(corner_type{p.x(), p.y(), p.z()});
+        }
+        /// Grow the box so that it includes a point
+        bounding_box &merge(vec3<D> const &p) { return merge(p.array()); }
+        /// Grow the box so that it includes a corner
+        bounding_box &merge(corner_type const &c) {
+            for (std::size_t axis{}; axis < 3; ++axis) {
+                lower[axis] = std::min(lower[axis], c[axis]);
+                upper[axis] = std::max(upper[axis], c[axis]);
+            }
+            return *this;
+        }
+        /// Grow the box so that it includes another box
+        bounding_box &merge(bounding_box const &b) {
+            for (std::size_t axis{}; axis < 3; ++axis) {
+                lower[axis] = std::min(lower[axis], b.lower[axis]);
+                upper[axis] = std::max(upper[axis], b.upper[axis]);
+            }
+            return *this;
+        }
+
+        /// The centre of the box along an axis. For unbounded boxes this
+        /// is the finite side, or zero if there isn't one
+        D centroid(std::size_t const axis) const {
+            bool const l = std::isfinite(lower[axis]),
+                       u = std::isfinite(upper[axis]);
+            if (l and u) {
+                return (lower[axis] + upper[axis]) / D{2};
+            } else if (l) {
+                return lower[axis];
+            } else if (u) {
+                return upper[axis];
+            } else {
+                return D{};
+            }
+        }
+
+        /// The surface area of the box. Zero for empty boxes
+        D surface_area() const {
+            if (empty()) { return D{}; }
+            auto const x = upper[0] - lower[0], y = upper[1] - lower[1],
+                       z = upper[2] - lower[2];
+            return D{2} * (x * y + y * z + z * x);
+        }
+
+        /// Linearly interpolate each corner towards those of `b`. Sides
+        /// that are the same in both boxes are left alone, and a side that
+        /// is infinite in either box stays infinite
+        bounding_box interpolate(bounding_box const &b, D const t) const {
+            auto const lerp = [t](D const from, D const to) {
+                if (from == to or not std::isfinite(from)) {
+                    return from;
+                } else if (not std::isfinite(to)) {
+                    return to;
+                } else {
+                    return from + (to - from) * t;
+                }
+            };
+            bounding_box r;
+            for (std::size_t axis{}; axis < 3; ++axis) {
+                r.lower[axis] = lerp(lower[axis], b.lower[axis]);
+                r.upper[axis] = lerp(upper[axis], b.upper[axis]);
+            }
+            return r;
+        }
+
+        /// The box grown by `d` on every side. Infinite sides stay as
+        /// they are
+        bounding_box grow(D const d) const {
+            bounding_box r{*this};
+            for (std::size_t axis{}; axis < 3; ++axis) {
+                r.lower[axis] -= d;
+                r.upper[axis] += d;
+            }
+            return r;
+        }
+
+        /// The axis along which the box is longest
+        std::size_t longest_axis() const {
+            auto const x = upper[0] - lower[0], y = upper[1] - lower[1],
+                       z = upper[2] - lower[2];
+            if (x >= y and x >= z) {
+                return 0;
+            } else if (y >= z) {
+                return 1;
+            } else {
+                return 2;
+            }
+        }
+
+        /// Return the box transformed by the matrix. Unbounded boxes stay
+        /// unbounded
+        template<typename M>
+        bounding_box transform(M const &m) const {
+            if (empty()) {
+                return {};
+            } else if (not is_finite()) {
+                return everything();
+            }
+            bounding_box r;
+            for (std::size_t corner{}; corner < 8; ++corner) {
+                r.merge(m
+                        * point3d<D>{
+                                (corner & 1) ? upper[0] : lower[0],
+                                (corner & 2) ? upper[1] : lower[1],
+                                (corner & 4) ? upper[2] : lower[2]});
+            }
+            return r;
+        }
+
+        /// Slab test. Returns the distance along the ray at which it enters
+        /// the box, if it does so before `t_max`
+        std::optional<D>
+                entry(bounding_ray<D> const &by,
+                      D const t_max = infinity) const {
+            D t_near{}, t_far{t_max};
+            for (std::size_t axis{}; axis < 3; ++axis) {
+                D t0 = (lower[axis] - by.from[axis])
+                        * by.inverse_direction[axis];
+                D t1 = (upper[axis] - by.from[axis])
+                        * by.inverse_direction[axis];
+                if (t0 > t1) { std::swap(t0, t1); }
+                /// Written so that a `NaN` (ray parallel to, and in the
+                /// plane of, a face) never narrows the interval
+                t_near = t0 > t_near ? t0 : t_near;
+                t_far = t1 < t_far ? t1 : t_far;
+                if (t_near > t_far) { return {}; }
+            }
+            return t_near;
+        }
+
+        /// Useful constant
+        static constexpr D infinity = std::numeric_limits<D>::infinity();
+    };
+
+
+}
+
+
+#endif // ANIMRAY_GEOMETRY_BOUNDING_BOX_HPP
@@ -0,0 +1,368 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_GEOMETRY_BVH_BUILDER_HPP
+#define ANIMRAY_GEOMETRY_BVH_BUILDER_HPP
+#pragma once
+
+
+#include <animray/geometry/bounding-box.hpp>
+#include <animray/threading/pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <numeric>
+#include <ostream>
+#include <vector>
+
+
+namespace animray {
+
+
+    /**
+     * # BVH builder
+     *
+     * Builds a bounding volume hierarchy over a set of bounding boxes using
+     * the surface area heuristic. Candidate splits are evaluated over a
+     * fixed number of bins along the longest centroid axis, which keeps
+     * each level linear in the number of instances. Large subtrees are
+     * built on their own threads, or as jobs on a `threading::pool`.
+     *
+     * Once built the node bounds can be refitted to instances that have
+     * moved without changing the shape of the hierarchy.
+     */
+
+
+    /// A node in the hierarchy. The children of an internal node are always
+    /// stored next to each other
+    template<typename D>
+    struct bvh_node {
+        /// The bounds of everything below this node
+        bounding_box<D> bounds;
+        /// For leaves the first instance, otherwise the first child
+        std::uint32_t offset{};
+        /// The number of instances in a leaf, zero for internal nodes
+        std::uint32_t count{};
+    };
+
+
+    /// Statistics gathered whilst building a hierarchy
+    struct bvh_build_stats {
+        /// Wall clock time taken by the build
+        std::chrono::steady_clock::duration time{};
+        /// The number of instances the hierarchy covers
+        std::size_t instances{};
+        /// The total number of nodes, and how many of them are leaves
+        std::size_t nodes{}, leaves{};
+        /// The depth of the deepest leaf
+        std::size_t depth{};
+    };
+    /// Output to a stream
+    inline std::ostream &operator<<(std::ostream &o, bvh_build_stats const &s) {
+        return o << s.instances << " instances, " << s.nodes << " nodes ("
+                 << s.leaves << " leaves, depth " << s.depth << ") in "
+                 << std::chrono::duration<double, std::milli>(s.time).count()
+                 << "ms";
+    }
+
+
+    namespace detail {
+        template<typename D>
+        class bvh_builder {
+            std::vector<bvh_node<D>> &nodes;
+            std::vector<bounding_box<D>> const &bounds;
+            std::vector<std::uint32_t> &order;
+            std::vector<std::array<D, 3>> centroids;
+            std::size_t const leaf_size, max_depth;
+            std::atomic<std::uint32_t> allocated{1};
+            std::atomic<std::size_t> spare_threads, leaves{}, deepest{};
+            threading::pool *const workers = nullptr;
+
+            static constexpr std::size_t bin_count = 16;
+            /// Subtrees smaller than this are never handed to another thread
+            static constexpr std::size_t parallel_threshold = 1024;
+            /// The cost of traversing a node relative to testing an instance
+            static constexpr D traversal_cost = D{1} / D{2};
+
+          public:
+            bvh_builder(
+                    std::vector<bvh_node<D>> &n,
+                    std::vector<bounding_box<D>> const &b,
+                    std::vector<std::uint32_t> &o,
+                    std::size_t const leaf,
+                    std::size_t const depth,
+                    std::size_t const threads)
+            : nodes{n},
+              bounds{b},
+              order{o},
+              leaf_size{leaf},
+              max_depth{depth},
+              spare_threads{threads > 1 ? threads - 1 : 0} {
+                find_centroids();
+            }
+            bvh_builder(
+                    std::vector<bvh_node<D>> &n,
+                    std::vector<bounding_box<D>> const &b,
+                    std::vector<std::uint32_t> &o,
+                    std::size_t const leaf,
+                    std::size_t const depth,
+                    threading::pool &p)
+            : nodes{n},
+              bounds{b},
+              order{o},
+              leaf_size{leaf},
+              max_depth{depth},
+              spare_threads{},
+              workers{&p} {
+                find_centroids();
+            }
+
+            bvh_build_stats operator()() {
+                auto const started = std::chrono::steady_clock::now();
+                nodes.clear();
+                order.resize(bounds.size());
+                std::iota(order.begin(), order.end(), std::uint32_t{});
+                if (not bounds.empty()) {
+                    nodes.resize(2 * bounds.size());
+                    split(0, 0, bounds.size(), 1);
+                    nodes.resize(allocated);
+                }
+                bvh_build_stats stats;
+                stats.time = std::chrono::steady_clock::now() - started;
+                stats.instances = bounds.size();
+                stats.nodes = nodes.size();
+                stats.leaves = leaves;
+                stats.depth = deepest;
+                return stats;
+            }
+
+          private:
+            void find_centroids() {
+                centroids.reserve(bounds.size());
+                for (auto const &box : bounds) {
+                    centroids.push_back(
+                            {box.centroid(0), box.centroid(1),
+                             box.centroid(2)});
+                }
+            }
+
+            void make_leaf(
+                    bvh_node<D> &node,
+                    std::size_t const begin,
+                    std::size_t const end,
+                    std::size_t const depth) {
+                node.offset = begin;
+                node.count = end - begin;
+                ++leaves;
+                auto seen = deepest.load();
+                while (seen < depth
+                       and not deepest.compare_exchange_weak(seen, depth)) {}
+            }
+
+            void split(
+                    std::uint32_t const me,
+                    std::size_t const begin,
+                    std::size_t const end,
+                    std::size_t const depth) {
+                auto &node = nodes[me];
+                bounding_box<D> centres;
+                for (auto index = begin; index != end; ++index) {
+                    node.bounds.merge(bounds[order[index]]);
+                    auto const &c = centroids[order[index]];
+                    for (std::size_t axis{}; axis < 3; ++axis) {
+                        centres.lower[axis] =
+                                std::min(centres.lower[axis], c[axis]);
+                        centres.upper[axis] =
+                                std::max(centres.upper[axis], c[axis]);
+                    }
+                }
+                std::size_t const count = end - begin;
+                if (count == 1 or depth >= max_depth) {
+                    return make_leaf(node, begin, end, depth);
+                }
+
+                std::size_t const axis = centres.longest_axis();
+                D const lower = centres.lower[axis],
+                        extent = centres.upper[axis] - lower;
+                std::size_t middle = begin + count / 2;
+                if (extent > D{}) {
+                    auto const bin_of = [&](std::uint32_t const i) {
+                        return std::min(
+                                bin_count - 1,
+                                std::size_t(
+                                        bin_count * (centroids[i][axis] - lower)
+                                        / extent));
+                    };
+                    std::array<bounding_box<D>, bin_count> boxes;
+                    std::array<std::size_t, bin_count> counts{};
+                    for (auto index = begin; index != end; ++index) {
+                        auto const bin = bin_of(order[index]);
+                        boxes[bin].merge(bounds[order[index]]);
+                        ++counts[bin];
+                    }
+                    /// Sweep from the right to find the cost of every
+                    /// right hand side, then from the left to find the best
+                    std::array<D, bin_count> right_cost{};
+                    bounding_box<D> sweep;
+                    std::size_t swept{};
+                    for (std::size_t bin = bin_count - 1; bin > 0; --bin) {
+                        sweep.merge(boxes[bin]);
+                        swept += counts[bin];
+                        right_cost[bin - 1] = sweep.surface_area() * swept;
+                    }
+                    sweep = {};
+                    swept = 0;
+                    D best_cost = bounding_box<D>::infinity;
+                    std::size_t best_bin = bin_count;
+                    for (std::size_t bin{}; bin < bin_count - 1; ++bin) {
+                        sweep.merge(boxes[bin]);
+                        swept += counts[bin];
+                        D const cost =
+                                sweep.surface_area() * swept + right_cost[bin];
+                        if (swept and swept != count and cost < best_cost) {
+                            best_cost = cost;
+                            best_bin = bin;
+                        }
+                    }
+                    D const area = node.bounds.surface_area();
+                    if (count <= leaf_size
+                        and count * area
+                                <= traversal_cost * area + best_cost) {
+                        return make_leaf(node, begin, end, depth);
+                    }
+                    if (best_bin != bin_count and std::isfinite(best_cost)) {
+                        middle = std::partition(
+                                         order.begin() + begin,
+                                         order.begin() + end,
+                                         [&](auto const i) {
+                                             return bin_of(i) <= best_bin;
+                                         })
+                                - order.begin();
+                    } else {
+                        /// Unbounded instances make every cost infinite
+                        /// so fall back to splitting at the median
+                        std::nth_element(
+                                order.begin() + begin, order.begin() + middle,
+                                order.begin() + end,
+                                [&](auto const l, auto const r) {
+                                    return centroids[l][axis]
+                                            < centroids[r][axis];
+                                });
+                    }
+                } else if (count <= leaf_size) {
+                    return make_leaf(node, begin, end, depth);
+                }
+
+                std::uint32_t const children = allocated.fetch_add(2);
+                node.offset = children;
+                node.count = 0;
+                if (count >= parallel_threshold and workers) {
+                    auto left = workers->submit([&]() {
+                        split(children, begin, middle, depth + 1);
+                    });
+                    split(children + 1, middle, end, depth + 1);
+                    workers->wait(std::move(left));
+                } else if (count >= parallel_threshold and claim_thread()) {
+                    auto left = std::async(std::launch::async, [&]() {
+                        split(children, begin, middle, depth + 1);
+                    });
+                    split(children + 1, middle, end, depth + 1);
+                    left.get();
+                    ++spare_threads;
+                } else {
+                    split(children, begin, middle, depth + 1);
+                    split(children + 1, middle, end, depth + 1);
+                }
+            }
+
+            bool claim_thread() {
+                auto spare = spare_threads.load();
+                while (spare) {
+                    if (spare_threads.compare_exchange_weak(spare, spare - 1)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+        };
+    }
+
+
+    /// Build a hierarchy over the bounding boxes. On return `order` holds
+    /// the permutation of the boxes that the leaves refer to
+    template<typename D>
+    bvh_build_stats build_bvh(
+            std::vector<bvh_node<D>> &nodes,
+            std::vector<bounding_box<D>> const &bounds,
+            std::vector<std::uint32_t> &order,
+            std::size_t const leaf_size,
+            std::size_t const max_depth,
+            std::size_t const threads = 1) {
+        return detail::bvh_builder<D>{
+                nodes, bounds, order, leaf_size, max_depth, threads}();
+    }
+
+
+    /// Build a hierarchy with the large subtrees queued as jobs on the pool
+    template<typename D>
+    bvh_build_stats build_bvh(
+            std::vector<bvh_node<D>> &nodes,
+            std::vector<bounding_box<D>> const &bounds,
+            std::vector<std::uint32_t> &order,
+            std::size_t const leaf_size,
+            std::size_t const max_depth,
+            threading::pool &workers) {
+        return detail::bvh_builder<D>{
+                nodes, bounds, order, leaf_size, max_depth, workers}();
+    }
+
+
+    /// Recalculate the bounds of every node for the current instance
+    /// bounds. `box(n)` returns where the bounds for node `n` are to be
+    /// stored and `instance_bounds(i)` the bounds of the instance at leaf
+    /// position `i`. Children are always stored after their parent so a
+    /// single backwards pass visits them first
+    template<typename D, typename B, typename I>
+    void refit_bvh(
+            std::vector<bvh_node<D>> const &nodes,
+            B &&box,
+            I &&instance_bounds) {
+        for (std::size_t index = nodes.size(); index--;) {
+            auto const &n = nodes[index];
+            bounding_box<D> fitted;
+            if (n.count) {
+                for (auto i = n.offset; i != n.offset + n.count; ++i) {
+                    fitted.merge(instance_bounds(i));
+                }
+            } else {
+                fitted.merge(box(n.offset)).merge(box(n.offset + 1));
+            }
+            box(index) = fitted;
+        }
+    }
+
+
+}
+
+
+#endif // ANIMRAY_GEOMETRY_BVH_BUILDER_HPP
@@ -0,0 +1,320 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_GEOMETRY_BVH_COLLECTION_HPP
+#define ANIMRAY_GEOMETRY_BVH_COLLECTION_HPP
+#pragma once
+
+
+#include <animray/geometry/bvh-builder.hpp>
+#include <animray/unbounded.hpp>
+
+#include <cmath>
+#include <optional>
+#include <vector>
+
+
+namespace animray {
+
+
+    /**
+     * # BVH collection
+     *
+     * A collection of objects of a single type stored in a bounding volume
+     * hierarchy. It answers the same `intersects` and `occludes` queries
+     * as `collection`, but only tests the instances whose bounds the ray
+     * passes through.
+     *
+     * The instance type must provide a `bounds()` member. The hierarchy is
+     * built by the constructor that takes the instances, or by calling
+     * `build()` after the last `insert`. Any extra arguments to `build()`
+     * are passed on to `bounds()`, which allows an animated collection to
+     * be built for a particular frame.
+     *
+     * For animations the hierarchy only needs to be built once. After that
+     * `refit()` recalculates the node bounds for the instances at a new
+     * frame, which is far cheaper than a rebuild. `refit_shutter()` fits
+     * each node around the bounds at `shutter_steps + 1` times spread
+     * across the shutter of a `movie`, so that rays at any frame time can
+     * use the same bounds. An instance can leave the samples' bounds
+     * between two of them, by no more than the sagitta of its path, so
+     * each node is also grown by the furthest any of its sides moved in a
+     * step. That covers anything that turns through less than half a
+     * circle in a step.
+     */
+
+
+    /// A collection of objects held in a bounding volume hierarchy
+    template<typename O, typename V = std::vector<O>>
+    class bvh_collection {
+      public:
+        /// The type of objects that can be inserted
+        using instance_type = O;
+        /// The type of the collection
+        using collection_type = V;
+        /// The type of the local coordinate system
+        using local_coord_type = typename instance_type::local_coord_type;
+        /// The type of the ray output by the instance
+        using intersection_type = typename O::intersection_type;
+        /// The bounding box type
+        using bounds_type = bounding_box<local_coord_type>;
+
+        /// The node type used for the hierarchy
+        using node = bvh_node<local_coord_type>;
+
+        /// The largest number of instances placed in a leaf
+        static constexpr std::size_t leaf_size = 4;
+        /// The deepest the hierarchy is allowed to go
+        static constexpr std::size_t max_depth = 64;
+
+        bvh_collection() = default;
+
+        explicit bvh_collection(V &&v, std::size_t const threads = 1)
+        : instances{std::move(v)} {
+            build(threads);
+        }
+
+        /// The instances. These are re-ordered by `build()`
+        collection_type instances;
+        /// The hierarchy nodes, the root is at the front
+        std::vector<node> nodes;
+
+        /// Insert a new object. `build()` must be called before rendering
+        template<typename G>
+        bvh_collection &insert(const G &instance) {
+            instances.push_back(instance);
+            nodes.clear();
+            return *this;
+        }
+
+        /// Build the hierarchy over the current instances using up to
+        /// `threads` threads
+        template<typename... P>
+        bvh_build_stats build(std::size_t const threads = 1, P const &...p) {
+            return build_using(threads, p...);
+        }
+        /// Build the hierarchy over the current instances with the large
+        /// subtrees built as jobs on the pool
+        template<typename... P>
+        bvh_build_stats build(threading::pool &workers, P const &...p) {
+            return build_using(workers, p...);
+        }
+
+        /// Recalculate the node bounds for the instances as they are at the
+        /// frame given by the parameters, keeping the current hierarchy
+        template<typename... P>
+        void refit(P const &...p) {
+            refit_bvh(
+                    nodes,
+                    [this](std::size_t const n) -> bounds_type & {
+                        return nodes[n].bounds;
+                    },
+                    [&](std::size_t const i) {
+                        return instances[i].bounds(p...);
+                    });
+        }
+        /// The number of steps the shutter is split into by
+        /// `refit_shutter()`
+        static constexpr std::size_t shutter_steps = 4;
+        /// Refit so that the bounds hold the instances at every frame time
+        /// from the `open` ray's to the `close` ray's, for rendering with
+        /// motion blur
+        template<typename R>
+        void refit_shutter(R const &open, R const &close) {
+            refit(open);
+            if (close.frame == open.frame) { return; }
+            std::vector<bounds_type> previous(nodes.size()),
+                    step(nodes.size());
+            std::vector<local_coord_type> moved(nodes.size());
+            for (std::size_t n{}; n < nodes.size(); ++n) {
+                previous[n] = nodes[n].bounds;
+            }
+            for (std::size_t s = 1; s <= shutter_steps; ++s) {
+                R at{open};
+                at.frame = open.frame
+                        + (close.frame - open.frame) * s / shutter_steps;
+                refit_bvh(
+                        nodes,
+                        [&](std::size_t const n) -> bounds_type & {
+                            return step[n];
+                        },
+                        [&](std::size_t const i) {
+                            return instances[i].bounds(at);
+                        });
+                for (std::size_t n{}; n < nodes.size(); ++n) {
+                    for (std::size_t axis{}; axis < 3; ++axis) {
+                        for (auto const d :
+                             {step[n].lower[axis] - previous[n].lower[axis],
+                              step[n].upper[axis] - previous[n].upper[axis]}) {
+                            if (std::isfinite(d)) {
+                                moved[n] = std::max(moved[n], std::abs(d));
+                            }
+                        }
+                    }
+                    nodes[n].bounds.merge(step[n]);
+                }
+                std::swap(previous, step);
+            }
+            /// A parent must be grown at least as much as its children, and
+            /// they always come after it
+            for (std::size_t n = nodes.size(); n--;) {
+                if (not nodes[n].count) {
+                    moved[n] = std::max(
+                            {moved[n], moved[nodes[n].offset],
+                             moved[nodes[n].offset + 1]});
+                }
+                nodes[n].bounds = nodes[n].bounds.grow(moved[n]);
+            }
+        }
+
+        /// The bounds of all of the instances
+        bounds_type bounds() const {
+            if (nodes.empty()) {
+                return {};
+            } else {
+                return nodes.front().bounds;
+            }
+        }
+
+        /// Ray intersection with closest item
+        template<typename R, typename E>
+        std::optional<intersection_type>
+                intersects(const R &by, const E epsilon) const {
+            std::optional<intersection_type> result;
+            if (nodes.empty()) { return result; }
+            bounding_ray<local_coord_type> const slab{by};
+            local_coord_type result_dot{}, t_max{bounds_type::infinity};
+            auto const t_root = nodes.front().bounds.entry(slab);
+            if (not t_root) { return result; }
+
+            std::array<std::pair<std::uint32_t, local_coord_type>, max_depth>
+                    stack;
+            std::size_t depth{};
+            std::pair<std::uint32_t, local_coord_type> current{0, *t_root};
+            while (true) {
+                if (current.second <= t_max) {
+                    node const &n = nodes[current.first];
+                    if (n.count) {
+                        for (auto index = n.offset; index != n.offset + n.count;
+                             ++index) {
+                            std::optional<intersection_type> intersection(
+                                    instances[index].intersects(by, epsilon));
+                            if (intersection) {
+                                local_coord_type const dot =
+                                        (intersection->from - by.from).dot();
+                                if (not result or dot < result_dot) {
+                                    result = std::move(intersection);
+                                    result_dot = dot;
+                                    t_max = std::sqrt(dot);
+                                }
+                            }
+                        }
+                    } else {
+                        auto const near = n.offset, far = n.offset + 1;
+                        auto const t_near =
+                                nodes[near].bounds.entry(slab, t_max);
+                        auto const t_far =
+                                nodes[far].bounds.entry(slab, t_max);
+                        if (t_near and t_far) {
+                            if (*t_far < *t_near) {
+                                stack[depth++] = {near, *t_near};
+                                current = {far, *t_far};
+                            } else {
+                                stack[depth++] = {far, *t_far};
+                                current = {near, *t_near};
+                            }
+                            continue;
+                        } else if (t_near) {
+                            current = {near, *t_near};
+                            continue;
+                        } else if (t_far) {
+                            current = {far, *t_far};
+                            continue;
+                        }
+                    }
+                }
+                if (depth == 0) { break; }
+                current = stack[--depth];
+            }
+            return result;
+        }
+
+        /// Occlusion check for anything closer than `t_max`. Nodes that
+        /// the ray only reaches after `t_max` are skipped
+        template<typename R, typename E>
+        bool occludes(
+                const R &by,
+                const E epsilon,
+                local_coord_type const t_max =
+                        unbounded<local_coord_type>) const {
+            if (nodes.empty()) { return false; }
+            bounding_ray<local_coord_type> const slab{by};
+            std::array<std::uint32_t, max_depth + 1> stack;
+            std::size_t depth{};
+            stack[depth++] = 0;
+            while (depth) {
+                node const &n = nodes[stack[--depth]];
+                if (not n.bounds.entry(slab, t_max)) { continue; }
+                if (n.count) {
+                    for (auto index = n.offset; index != n.offset + n.count;
+                         ++index) {
+                        if (instances[index].occludes(by, epsilon, t_max)) {
+                            return true;
+                        }
+                    }
+                } else {
+                    stack[depth++] = n.offset;
+                    stack[depth++] = n.offset + 1;
+                }
+            }
+            return false;
+        }
+
+      private:
+        /// Build the hierarchy where `workers` is either a thread count or
+        /// a pool
+        template<typename W, typename... P>
+        bvh_build_stats build_using(W &workers, P const &...p) {
+            std::vector<bounds_type> bounds;
+            bounds.reserve(instances.size());
+            for (auto const &instance : instances) {
+                bounds.push_back(instance.bounds(p...));
+            }
+            std::vector<std::uint32_t> order;
+            auto const stats = build_bvh(
+                    nodes, bounds, order, leaf_size, max_depth, workers);
+            std::vector<instance_type> const original(
+                    instances.cbegin(), instances.cend());
+            for (std::size_t index{}; index < order.size(); ++index) {
+                instances[index] = original[order[index]];
+            }
+            return stats;
+        }
+    };
+
+
+    template<typename V>
+    bvh_collection(V &&) -> bvh_collection<typename V::value_type, V>;
+
+
+}
+
+
+#endif // ANIMRAY_GEOMETRY_BVH_COLLECTION_HPP
@@ -23,6 +23,11 @@
 #pragma once
 
 
+#include <animray/geometry/bounding-box.hpp>
+#include <animray/ray-packet.hpp>
+#include <animray/unbounded.hpp>
+
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -61,6 +66,16 @@ namespace animray {
             return *this;
         }
 
+        /// The bounds of all of the instances
+        template<typename... P>
+        bounding_box<local_coord_type> bounds(P const &...p) const {
+            bounding_box<local_coord_type> b;
+            for (const auto &instance : instances) {
+                b.merge(instance.bounds(p...));
+            }
+            return b;
+        }
+
         /// Ray intersection with closest item
         template<typename R, typename E>
         std::optional<intersection_type>
@@ -87,16 +102,53 @@ namespace animray {
             return result;
         }
 
-        /// Occlusion check
+        /// Occlusion check for anything closer than `t_max`
         template<typename R, typename E>
-        bool occludes(const R &by, const E epsilon) const {
+        bool occludes(
+                const R &by,
+                const E epsilon,
+                local_coord_type const t_max =
+                        unbounded<local_coord_type>) const {
             return std::find_if(
                            instances.begin(), instances.end(),
-                           [&by, epsilon](const instance_type &instance) {
-                               return instance.occludes(by, epsilon);
+                           [&by, epsilon,
+                            t_max](const instance_type &instance) {
+                               return instance.occludes(by, epsilon, t_max);
                            })
                     != instances.end();
         }
+
+        /// Update the lanes of `closest` that strike an instance nearer
+        /// than what has already been found
+        template<typename PD, std::size_t N, typename E>
+        void intersects(
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                packet_intersection<intersection_type, N> &closest) const {
+            for (const auto &instance : instances) {
+                instance.intersects(by, epsilon, closest);
+            }
+        }
+
+        /// The active lanes that are blocked before their `t_max`. Lanes
+        /// are dropped from the packet as soon as they are blocked
+        template<typename PD, std::size_t N, typename E>
+        lane_mask<N> occludes(
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                std::array<local_coord_type, N> const &t_max) const {
+            lane_mask<N> blocked{};
+            ray_packet<PD, N> remaining{by};
+            for (const auto &instance : instances) {
+                auto const hit = instance.occludes(remaining, epsilon, t_max);
+                blocked = either(blocked, hit);
+                for (std::size_t lane{}; lane < N; ++lane) {
+                    remaining.active[lane] &= not hit[lane];
+                }
+                if (not any(remaining.active)) { break; }
+            }
+            return blocked;
+        }
     };
 
 
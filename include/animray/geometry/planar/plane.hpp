@@ -23,7 +23,10 @@
 #pragma once
 
 
+#include <animray/geometry/bounding-box.hpp>
 #include <animray/maths/dot.hpp>
+#include <animray/ray-packet.hpp>
+#include <animray/unbounded.hpp>
 #include <optional>
 
 
@@ -38,9 +41,25 @@ namespace animray {
         using intersection_type = I;
 
         /// The centre of the plane
-        point3d<local_coord_type> center;
+        typename intersection_type::end_type center;
         /// Surface normal
-        unit_vector<local_coord_type> normal;
+        typename intersection_type::direction_type normal;
+
+        /// The bounding box of the plane. Planes aligned with two of the
+        /// axes are flat along the third, all others are unbounded
+        bounding_box<local_coord_type> bounds() const {
+            auto b = bounding_box<local_coord_type>::everything();
+            local_coord_type const n[3] = {normal.x(), normal.y(), normal.z()},
+                                   c[3] = {center.x(), center.y(), center.z()};
+            for (std::size_t axis{}; axis < 3; ++axis) {
+                if (n[(axis + 1) % 3] == local_coord_type{}
+                    and n[(axis + 2) % 3] == local_coord_type{}) {
+                    b.lower[axis] = c[axis];
+                    b.upper[axis] = c[axis];
+                }
+            }
+            return b;
+        }
 
         /// Calculate the intersection point
         template<typename R, typename E>
@@ -61,10 +80,85 @@ namespace animray {
             }
         }
 
-        /// Returns true if the ray hits the sphere
+        /// Returns true if the ray hits the plane before `t_max`
         template<typename R, typename E>
-        bool occludes(R by, const E epsilon) const {
-            return intersects(by, epsilon).has_value();
+        bool occludes(
+                R by,
+                const E epsilon,
+                local_coord_type const t_max =
+                        unbounded<local_coord_type>) const {
+            const local_coord_type dot_normal(
+                    animray::dot(by.direction, normal));
+            if (dot_normal == local_coord_type()) { return false; }
+            const local_coord_type t(
+                    animray::dot(normal, center - by.from) / dot_normal);
+            return t > epsilon and t < t_max;
+        }
+
+        /// Update the lanes of `closest` for which the plane is nearer
+        template<typename PD, std::size_t N, typename E>
+        void intersects(
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                packet_intersection<intersection_type, N> &closest) const {
+            std::array<local_coord_type, N> t, facing;
+            distances(by, epsilon, t, facing);
+            for (std::size_t lane{}; lane < N; ++lane) {
+                if (t[lane] < closest.distance[lane]) {
+                    auto const r = by[lane];
+                    closest.distance[lane] = t[lane];
+                    closest.hit[lane] = intersection_type(
+                            r.from + r.direction * t[lane],
+                            facing[lane] < 0 ? normal : -normal);
+                }
+            }
+        }
+
+        /// The active lanes of the packet that hit the plane before their
+        /// `t_max`
+        template<typename PD, std::size_t N, typename E>
+        lane_mask<N> occludes(
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                std::array<local_coord_type, N> const &t_max) const {
+            std::array<local_coord_type, N> t, facing;
+            distances(by, epsilon, t, facing);
+            lane_mask<N> blocked;
+            for (std::size_t lane{}; lane < N; ++lane) {
+                blocked[lane] = t[lane] < t_max[lane];
+            }
+            return blocked;
+        }
+
+      private:
+        /// The distance to the plane for each lane of a packet, `unbounded`
+        /// for those that miss or are not active. `facing` is the dot
+        /// product of the ray direction with the normal
+        template<typename P, typename E>
+        void distances(
+                P const &by,
+                const E epsilon,
+                std::array<local_coord_type, P::lanes> &t,
+                std::array<local_coord_type, P::lanes> &facing) const {
+            D const nx = normal.x(), ny = normal.y(), nz = normal.z();
+            D const cx = center.x(), cy = center.y(), cz = center.z();
+            for (std::size_t lane{}; lane < P::lanes; ++lane) {
+                D const dot_normal = by.direction[0][lane] * nx
+                        + by.direction[1][lane] * ny
+                        + by.direction[2][lane] * nz;
+                D const numerator = nx * (cx - by.from[0][lane])
+                        + ny * (cy - by.from[1][lane])
+                        + nz * (cz - by.from[2][lane]);
+                D const distance = numerator / dot_normal;
+                facing[lane] = dot_normal;
+                t[lane] = ((dot_normal != D{}) & (distance > D(epsilon)))
+                        ? distance
+                        : unbounded<D>;
+            }
+            /// Kept out of the loop above so that it still vectorises
+            for (std::size_t lane{}; lane < P::lanes; ++lane) {
+                if (not by.active[lane]) { t[lane] = unbounded<D>; }
+            }
         }
     };
 
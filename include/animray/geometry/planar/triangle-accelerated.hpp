@@ -0,0 +1,168 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_PLANAR_TRIANGLE_ACCELERATED_HPP
+#define ANIMRAY_PLANAR_TRIANGLE_ACCELERATED_HPP
+#pragma once
+
+
+#include <animray/geometry/bounding-box.hpp>
+#include <animray/maths/cross.hpp>
+#include <animray/unbounded.hpp>
+
+#include <array>
+#include <optional>
+
+
+namespace animray {
+
+
+    /**
+     * # Accelerated triangle
+     *
+     * Has the same `intersects` and `occludes` members as `triangle`, but
+     * works out the edges and the face normal when the triangle is built
+     * rather than for every ray. The corner and edges are stored as plain
+     * co-ordinates so that the hot loop doesn't need to divide through by
+     * the homogeneous `w`. This costs a little more memory per triangle.
+     */
+
+
+    template<typename I, typename D = typename I::local_coord_type>
+    class accelerated_triangle {
+      public:
+        /// The type of the local coordinates used
+        using local_coord_type = D;
+        /// Type of intersection to be returned
+        using intersection_type = I;
+        /// The type of the corners
+        using corner_type = point3d<local_coord_type>;
+
+        /// Construct a triangle from three points
+        accelerated_triangle(
+                corner_type const &one,
+                corner_type const &two,
+                corner_type const &three)
+        : origin{plain(one)},
+          e1{plain(two - one)},
+          e2{plain(three - one)},
+          normal{cross(three - one, two - one)},
+          box{bounding_box<local_coord_type>{}.merge(one).merge(two).merge(
+                  three)} {}
+
+        /// The bounding box of the triangle
+        bounding_box<local_coord_type> bounds() const { return box; }
+
+        /// Calculate the intersection point
+        template<typename R, typename E>
+        std::optional<intersection_type>
+                intersects(const R &by, const E epsilon) const {
+            vector const direction{plain(by.direction)};
+            local_coord_type const t(distance(by, direction, epsilon));
+            if (t > epsilon) {
+                if (dot(normal, direction) < local_coord_type{}) {
+                    return intersection_type(
+                            by.from + by.direction * t, normal);
+                } else {
+                    return intersection_type(
+                            by.from + by.direction * t, -normal);
+                }
+            } else {
+                return {};
+            }
+        }
+
+        /// Returns true if the ray hits the triangle before `t_max`
+        template<typename R, typename E>
+        bool occludes(
+                const R &by,
+                const E epsilon,
+                local_coord_type const t_max =
+                        unbounded<local_coord_type>) const {
+            local_coord_type const t(
+                    distance(by, plain(by.direction), epsilon));
+            return t > epsilon and t < t_max;
+        }
+
+      private:
+        using vector = std::array<local_coord_type, 3>;
+        using direction_type = typename intersection_type::direction_type;
+
+        vector origin, e1, e2;
+        direction_type normal;
+        bounding_box<local_coord_type> box;
+
+        template<typename P>
+        static vector plain(P const &p) {
+            return {p.x(), p.y(), p.z()};
+        }
+        static vector cross(vector const &b, vector const &c) {
+            return {b[1] * c[2] - b[2] * c[1], b[2] * c[0] - b[0] * c[2],
+                    b[0] * c[1] - b[1] * c[0]};
+        }
+        template<typename P>
+        static direction_type cross(P const &b, P const &c) {
+            return direction_type{animray::cross(b, c)};
+        }
+        static local_coord_type dot(vector const &b, vector const &c) {
+            return b[0] * c[0] + b[1] * c[1] + b[2] * c[2];
+        }
+        static local_coord_type
+                dot(direction_type const &n, vector const &c) {
+            return n.x() * c[0] + n.y() * c[1] + n.z() * c[2];
+        }
+
+        /// The distance along the ray to where it strikes the triangle, or
+        /// zero if it misses. This is the same Möller–Trumbore test that
+        /// `triangle` uses
+        template<typename R, typename E>
+        local_coord_type distance(
+                const R &by,
+                vector const &direction,
+                const E epsilon) const {
+            vector const P(cross(direction, e2));
+            local_coord_type const determinant(dot(e1, P));
+            if (determinant > -epsilon && determinant < epsilon) { return {}; }
+            local_coord_type const inv_determinant(
+                    local_coord_type(1) / determinant);
+
+            vector const T{
+                    by.from.x() - origin[0], by.from.y() - origin[1],
+                    by.from.z() - origin[2]};
+            local_coord_type const u(dot(T, P) * inv_determinant);
+            if (u < local_coord_type() || u > local_coord_type(1)) {
+                return {};
+            }
+
+            vector const Q(cross(T, e1));
+            local_coord_type const v(dot(direction, Q) * inv_determinant);
+            if (v < local_coord_type() || u + v > local_coord_type(1)) {
+                return {};
+            }
+
+            return dot(e2, Q) * inv_determinant;
+        }
+    };
+
+
+}
+
+
+#endif // ANIMRAY_PLANAR_TRIANGLE_ACCELERATED_HPP
@@ -0,0 +1,246 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_PLANAR_TRIANGLE_BATCH_HPP
+#define ANIMRAY_PLANAR_TRIANGLE_BATCH_HPP
+#pragma once
+
+
+#include <animray/geometry/bounding-box.hpp>
+#include <animray/geometry/planar/triangle.hpp>
+#include <animray/unbounded.hpp>
+
+#include <array>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+
+namespace animray {
+
+
+    /**
+     * # Triangle batch
+     *
+     * Stores triangles in groups of `N` with each co-ordinate of the
+     * corner and edges held in its own array (structure of arrays). A ray
+     * is tested against all `N` triangles of a group in one pass of a
+     * loop with no branches in it, which the compiler turns into SIMD
+     * instructions. `N` should match the vector width being compiled for:
+     * 4 for SSE or NEON and 8 for AVX2 with `float`.
+     *
+     * A batch can be used in place of a `collection` of triangles, or as
+     * the instance type of a `bvh_collection` so that each leaf tests a
+     * whole group at once. For the latter the triangles in each batch
+     * should be close together, for example by taking them in order from
+     * the `instances` of a built `bvh_collection<triangle>`.
+     */
+
+
+    template<
+            typename I,
+            std::size_t N = 4,
+            typename D = typename I::local_coord_type>
+    class triangle_batch {
+        static_assert(
+                std::is_floating_point_v<D>,
+                "Triangle batches need a floating point co-ordinate type");
+
+      public:
+        /// The type of the local coordinates used
+        using local_coord_type = D;
+        /// Type of intersection to be returned
+        using intersection_type = I;
+        /// The type of the corners
+        using corner_type = point3d<local_coord_type>;
+        /// The number of triangles tested together
+        static constexpr std::size_t lanes = N;
+
+        /// Construct an empty batch
+        triangle_batch() = default;
+        /// Construct a batch holding the triangles
+        template<typename T>
+        explicit triangle_batch(std::vector<T> const &triangles) {
+            for (auto const &t : triangles) { insert(t); }
+        }
+
+        /// Add a triangle to the batch
+        triangle_batch &insert(
+                corner_type const &one,
+                corner_type const &two,
+                corner_type const &three) {
+            if (size % N == 0) { groups.emplace_back(); }
+            group &g = groups.back();
+            std::size_t const lane = size % N;
+            corner_type const e1{two - one}, e2{three - one};
+            g.origin[0][lane] = one.x();
+            g.origin[1][lane] = one.y();
+            g.origin[2][lane] = one.z();
+            g.e1[0][lane] = e1.x();
+            g.e1[1][lane] = e1.y();
+            g.e1[2][lane] = e1.z();
+            g.e2[0][lane] = e2.x();
+            g.e2[1][lane] = e2.y();
+            g.e2[2][lane] = e2.z();
+            normals.emplace_back(cross(e2, e1));
+            box.merge(one).merge(two).merge(three);
+            ++size;
+            return *this;
+        }
+        /// Add a triangle to the batch
+        template<typename R>
+        triangle_batch &insert(triangle<R, local_coord_type> const &t) {
+            auto const &c = t.corners();
+            return insert(c[0], c[1], c[2]);
+        }
+
+        /// The number of triangles in the batch
+        std::size_t triangles() const { return size; }
+
+        /// The bounding box of all of the triangles
+        bounding_box<local_coord_type> bounds() const { return box; }
+
+        /// Ray intersection with the closest triangle
+        template<typename R, typename E>
+        std::optional<intersection_type>
+                intersects(const R &by, const E epsilon) const {
+            plain_ray const ray{by};
+            local_coord_type closest{unbounded<local_coord_type>};
+            std::size_t hit{size};
+            std::array<local_coord_type, N> t;
+            for (std::size_t index{}; index < groups.size(); ++index) {
+                distances(ray, groups[index], local_coord_type(epsilon), t);
+                for (std::size_t lane{}; lane < N; ++lane) {
+                    if (t[lane] < closest) {
+                        closest = t[lane];
+                        hit = index * N + lane;
+                    }
+                }
+            }
+            if (hit == size) { return {}; }
+            auto const &normal = normals[hit];
+            if (dot(normal, by.direction) < local_coord_type{}) {
+                return intersection_type(
+                        by.from + by.direction * closest, normal);
+            } else {
+                return intersection_type(
+                        by.from + by.direction * closest, -normal);
+            }
+        }
+
+        /// Returns true if the ray hits any triangle before `t_max`
+        template<typename R, typename E>
+        bool occludes(
+                const R &by,
+                const E epsilon,
+                local_coord_type const t_max =
+                        unbounded<local_coord_type>) const {
+            plain_ray const ray{by};
+            std::array<local_coord_type, N> t;
+            for (auto const &g : groups) {
+                distances(ray, g, local_coord_type(epsilon), t);
+                bool occluded{false};
+                for (std::size_t lane{}; lane < N; ++lane) {
+                    occluded |= (t[lane] < t_max);
+                }
+                if (occluded) { return true; }
+            }
+            return false;
+        }
+
+      private:
+        using lane_type = std::array<local_coord_type, N>;
+        using direction_type = typename intersection_type::direction_type;
+
+        /// `N` triangles. Unused lanes are left with zero length edges,
+        /// which can never be struck
+        struct group {
+            std::array<lane_type, 3> origin{}, e1{}, e2{};
+        };
+
+        /// The ray without homogeneous co-ordinates
+        struct plain_ray {
+            std::array<local_coord_type, 3> from, direction;
+            template<typename R>
+            explicit plain_ray(R const &by)
+            : from{by.from.x(), by.from.y(), by.from.z()},
+              direction{by.direction.x(), by.direction.y(), by.direction.z()} {
+            }
+        };
+
+        std::vector<group> groups;
+        std::vector<direction_type> normals;
+        bounding_box<local_coord_type> box;
+        std::size_t size{};
+
+        /// Möller–Trumbore for every lane of the group. Each lane of `t`
+        /// is the distance to that triangle, or `unbounded` for a miss
+        static void distances(
+                plain_ray const &by,
+                group const &g,
+                local_coord_type const epsilon,
+                lane_type &t) {
+            local_coord_type const zero{}, one{1},
+                    miss{unbounded<local_coord_type>};
+            auto const &d = by.direction;
+            for (std::size_t lane{}; lane < N; ++lane) {
+                local_coord_type const e1x = g.e1[0][lane],
+                                       e1y = g.e1[1][lane],
+                                       e1z = g.e1[2][lane];
+                local_coord_type const e2x = g.e2[0][lane],
+                                       e2y = g.e2[1][lane],
+                                       e2z = g.e2[2][lane];
+
+                local_coord_type const px = d[1] * e2z - d[2] * e2y,
+                                       py = d[2] * e2x - d[0] * e2z,
+                                       pz = d[0] * e2y - d[1] * e2x;
+                local_coord_type const determinant =
+                        e1x * px + e1y * py + e1z * pz;
+                local_coord_type const inv_determinant = one / determinant;
+
+                local_coord_type const tx = by.from[0] - g.origin[0][lane],
+                                       ty = by.from[1] - g.origin[1][lane],
+                                       tz = by.from[2] - g.origin[2][lane];
+                local_coord_type const u =
+                        (tx * px + ty * py + tz * pz) * inv_determinant;
+
+                local_coord_type const qx = ty * e1z - tz * e1y,
+                                       qy = tz * e1x - tx * e1z,
+                                       qz = tx * e1y - ty * e1x;
+                local_coord_type const v =
+                        (d[0] * qx + d[1] * qy + d[2] * qz) * inv_determinant;
+                local_coord_type const distance =
+                        (e2x * qx + e2y * qy + e2z * qz) * inv_determinant;
+
+                bool const struck = (determinant <= -epsilon)
+                        | (determinant >= epsilon);
+                bool const inside = (u >= zero) & (u <= one) & (v >= zero)
+                        & (u + v <= one);
+                t[lane] = (struck & inside & (distance > epsilon)) ? distance
+                                                                   : miss;
+            }
+        }
+    };
+
+
+}
+
+
+#endif // ANIMRAY_PLANAR_TRIANGLE_BATCH_HPP
@@ -23,24 +23,29 @@
 #pragma once
 
 
+#include <animray/geometry/bounding-box.hpp>
 #include <animray/maths/cross.hpp>
 #include <animray/maths/dot.hpp>
+#include <animray/ray-packet.hpp>
+#include <animray/unbounded.hpp>
 
 
 namespace animray {
 
 
     template<typename I, typename D = typename I::local_coord_type>
-    class triangle : private detail::array_based<point3d<D>, 3> {
-        typedef detail::array_based<point3d<D>, 3> superclass;
+    class triangle :
+    private detail::array_based<typename I::end_type, 3> {
+        typedef detail::array_based<typename I::end_type, 3> superclass;
 
       public:
         /// The type of the local coordinates used
         using local_coord_type = D;
         /// Type of intersection to be returned
         using intersection_type = I;
-        /// The type of the corners
-        using corner_type = point3d<local_coord_type>;
+        /// The type of the corners, which matches the locations used by the
+        /// intersection
+        using corner_type = typename intersection_type::end_type;
 
         /// Construct a triangle from three points
         constexpr triangle(
@@ -50,14 +55,108 @@ namespace animray {
             superclass::array[2] = std::move(three);
         }
 
+        /// The three corners
+        std::array<corner_type, 3> const &corners() const {
+            return superclass::array;
+        }
+
+        /// The bounding box of the triangle
+        bounding_box<local_coord_type> bounds() const {
+            return bounding_box<local_coord_type>{}
+                    .merge(superclass::array[0])
+                    .merge(superclass::array[1])
+                    .merge(superclass::array[2]);
+        }
+
         /// Calculate the intersection point
         template<typename R, typename E>
         std::optional<intersection_type>
-                intersects(R by, const E epsilon) const {
-            // Möller–Trumbore intersection algorithm
+                intersects(const R &by, const E epsilon) const {
             const corner_type e1(superclass::array[1] - superclass::array[0]);
             const corner_type e2(superclass::array[2] - superclass::array[0]);
+            const local_coord_type t(distance(by, epsilon, e1, e2));
+            if (t > epsilon) {
+                typename intersection_type::direction_type normal(
+                        cross(e2, e1).unit());
+                if (dot(normal, by.direction) < local_coord_type{}) {
+                    return intersection_type(
+                            by.from + by.direction * t, normal);
+                } else {
+                    return intersection_type(
+                            by.from + by.direction * t, -normal);
+                }
+            } else {
+                return {};
+            }
+        }
 
+        /// Returns true if the ray hits the triangle before `t_max`. Only
+        /// the distance is calculated, the normal and intersection are not
+        template<typename R, typename E>
+        bool occludes(
+                const R &by,
+                const E epsilon,
+                local_coord_type const t_max =
+                        unbounded<local_coord_type>) const {
+            const local_coord_type t(distance(
+                    by, epsilon, superclass::array[1] - superclass::array[0],
+                    superclass::array[2] - superclass::array[0]));
+            return t > epsilon and t < t_max;
+        }
+
+        /// Update the lanes of `closest` for which the triangle is nearer
+        template<typename PD, std::size_t N, typename E>
+        void intersects(
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                packet_intersection<intersection_type, N> &closest) const {
+            std::array<local_coord_type, N> t;
+            distances(by, epsilon, t);
+            const corner_type e1(superclass::array[1] - superclass::array[0]);
+            const corner_type e2(superclass::array[2] - superclass::array[0]);
+            std::optional<typename intersection_type::direction_type> normal;
+            for (std::size_t lane{}; lane < N; ++lane) {
+                if (t[lane] < closest.distance[lane]) {
+                    if (not normal) { normal.emplace(cross(e2, e1).unit()); }
+                    auto const r = by[lane];
+                    closest.distance[lane] = t[lane];
+                    if (dot(*normal, r.direction) < local_coord_type{}) {
+                        closest.hit[lane] = intersection_type(
+                                r.from + r.direction * t[lane], *normal);
+                    } else {
+                        closest.hit[lane] = intersection_type(
+                                r.from + r.direction * t[lane], -*normal);
+                    }
+                }
+            }
+        }
+
+        /// The active lanes of the packet that hit the triangle before
+        /// their `t_max`
+        template<typename PD, std::size_t N, typename E>
+        lane_mask<N> occludes(
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                std::array<local_coord_type, N> const &t_max) const {
+            std::array<local_coord_type, N> t;
+            distances(by, epsilon, t);
+            lane_mask<N> blocked;
+            for (std::size_t lane{}; lane < N; ++lane) {
+                blocked[lane] = t[lane] < t_max[lane];
+            }
+            return blocked;
+        }
+
+      private:
+        /// The distance along the ray to where it strikes the triangle, or
+        /// zero if it misses. Uses the Möller–Trumbore intersection
+        /// algorithm with the edges `e1` and `e2` from the first corner
+        template<typename R, typename E>
+        local_coord_type distance(
+                const R &by,
+                const E epsilon,
+                const corner_type &e1,
+                const corner_type &e2) const {
             const corner_type P(cross(by.direction, e2));
             const local_coord_type determinant(dot(e1, P));
             if (determinant > -epsilon && determinant < epsilon) { return {}; }
@@ -76,26 +175,54 @@ namespace animray {
                 return {};
             }
 
-            const local_coord_type t(dot(e2, Q) * inv_determinant);
-            if (t > epsilon) {
-                typename intersection_type::direction_type normal(
-                        cross(e2, e1));
-                if (dot(normal, by.direction) < local_coord_type{}) {
-                    return intersection_type(
-                            by.from + by.direction * t, normal);
-                } else {
-                    return intersection_type(
-                            by.from + by.direction * t, -normal);
-                }
-            } else {
-                return {};
-            }
+            return dot(e2, Q) * inv_determinant;
         }
 
-        /// Returns true if the ray hits the triangle
-        template<typename R, typename E>
-        bool occludes(R by, const E epsilon) const {
-            return intersects(by, epsilon).has_value();
+        /// The Möller–Trumbore test for every lane of a packet. Lanes that
+        /// miss, or are not active, are `unbounded`
+        template<typename P, typename E>
+        void distances(
+                P const &by,
+                const E epsilon,
+                std::array<local_coord_type, P::lanes> &t) const {
+            const corner_type c0(superclass::array[0]),
+                    c1(superclass::array[1] - c0),
+                    c2(superclass::array[2] - c0);
+            D const ox = c0.x(), oy = c0.y(), oz = c0.z();
+            D const e1x = c1.x(), e1y = c1.y(), e1z = c1.z();
+            D const e2x = c2.x(), e2y = c2.y(), e2z = c2.z();
+            D const zero{}, one{1}, eps(epsilon), miss{unbounded<D>};
+            auto const &d = by.direction;
+            for (std::size_t lane{}; lane < P::lanes; ++lane) {
+                D const px = d[1][lane] * e2z - d[2][lane] * e2y,
+                        py = d[2][lane] * e2x - d[0][lane] * e2z,
+                        pz = d[0][lane] * e2y - d[1][lane] * e2x;
+                D const determinant = e1x * px + e1y * py + e1z * pz;
+                D const inv_determinant = one / determinant;
+
+                D const tx = by.from[0][lane] - ox, ty = by.from[1][lane] - oy,
+                        tz = by.from[2][lane] - oz;
+                D const u = (tx * px + ty * py + tz * pz) * inv_determinant;
+
+                D const qx = ty * e1z - tz * e1y, qy = tz * e1x - tx * e1z,
+                        qz = tx * e1y - ty * e1x;
+                D const v = (d[0][lane] * qx + d[1][lane] * qy
+                             + d[2][lane] * qz)
+                        * inv_determinant;
+                D const distance =
+                        (e2x * qx + e2y * qy + e2z * qz) * inv_determinant;
+
+                bool const struck =
+                        (determinant <= -eps) | (determinant >= eps);
+                bool const inside = (u >= zero) & (u <= one) & (v >= zero)
+                        & (u + v <= one);
+                t[lane] = (struck & inside & (distance > eps)) ? distance
+                                                               : miss;
+            }
+            /// Kept out of the loop above so that it still vectorises
+            for (std::size_t lane{}; lane < P::lanes; ++lane) {
+                if (not by.active[lane]) { t[lane] = miss; }
+            }
         }
     };
 
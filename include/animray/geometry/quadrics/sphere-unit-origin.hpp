@@ -24,10 +24,14 @@
 
 
 #include <animray/epsilon.hpp>
+#include <animray/geometry/bounding-box.hpp>
 #include <animray/ray.hpp>
+#include <animray/ray-packet.hpp>
 #include <animray/maths/dot.hpp>
 #include <animray/maths/quadratic.hpp>
 
+#include <algorithm>
+
 
 namespace animray {
 
@@ -45,6 +49,11 @@ namespace animray {
         /// Check for inequality
         bool operator!=(const unit_sphere_at_origin &) const { return false; }
 
+        /// The bounding box of the sphere
+        bounding_box<D> bounds() const {
+            return {{D{-1}, D{-1}, D{-1}}, {D{1}, D{1}, D{1}}};
+        }
+
         /// Returns the b c values for the quadratic given a start and direction
         template<typename R>
         static std::pair<D, D> quadratic_b_c(const R &by) {
@@ -61,20 +70,95 @@ namespace animray {
             const std::optional<D> t(first_positive_quadratic_solution(
                     D(1), bc.first, bc.second, eps));
             if (t) {
-                using end_type = typename ray<D>::end_type;
-                using direction_type = typename ray<D>::direction_type;
-                direction_type normal(by.from + by.direction * *t);
+                using end_type = typename intersection_type::end_type;
+                using direction_type =
+                        typename intersection_type::direction_type;
+                direction_type normal((by.from + by.direction * *t).unit());
                 return intersection_type(end_type(normal), normal);
             } else {
                 return {};
             }
         }
 
-        /// Returns true if the ray hits the sphere
+        /// Returns true if the ray hits the sphere before `t_max`
         template<typename R>
-        bool occludes(const R &by, D const eps = epsilon<D>) const {
+        bool occludes(
+                const R &by,
+                D const eps = epsilon<D>,
+                D const t_max = unbounded<D>) const {
             const std::pair<D, D> bc(quadratic_b_c(by));
-            return quadratic_has_solution(D(1), bc.first, bc.second, eps);
+            return quadratic_has_solution(
+                    D(1), bc.first, bc.second, eps, t_max);
+        }
+
+        /// Update the lanes of `closest` for which the sphere is nearer
+        template<typename PD, std::size_t N, typename E>
+        void intersects(
+                ray_packet<PD, N> const &by,
+                E const eps,
+                packet_intersection<intersection_type, N> &closest) const {
+            std::array<D, N> t;
+            lane_mask<N> struck;
+            for (std::size_t lane{}; lane < N; ++lane) {
+                auto const [b, c] = packet_b_c(by, lane);
+                D const discrim = b * b - D{4} * c;
+                D const root = std::sqrt(discrim < D{} ? D{} : discrim);
+                D const q = -(b + (b < D{} ? -root : root)) / D{2};
+                D const t0 = std::min(q, c / q), t1 = std::max(q, c / q);
+                t[lane] = t0 < D{} ? t1 : t0;
+                struck[lane] = (discrim >= D{}) & (t[lane] >= D(eps))
+                        & (t[lane] < closest.distance[lane]);
+            }
+            using end_type = typename intersection_type::end_type;
+            using direction_type = typename intersection_type::direction_type;
+            for (std::size_t lane{}; lane < N; ++lane) {
+                if (by.active[lane] and struck[lane]) {
+                    auto const r = by[lane];
+                    direction_type normal(
+                            (r.from + r.direction * t[lane]).unit());
+                    closest.distance[lane] = t[lane];
+                    closest.hit[lane] =
+                            intersection_type(end_type(normal), normal);
+                }
+            }
+        }
+
+        /// The active lanes of the packet that hit the sphere before their
+        /// `t_max`
+        template<typename PD, std::size_t N>
+        lane_mask<N> occludes(
+                ray_packet<PD, N> const &by,
+                D const eps,
+                std::array<D, N> const &t_max) const {
+            lane_mask<N> blocked;
+            for (std::size_t lane{}; lane < N; ++lane) {
+                auto const [b, c] = packet_b_c(by, lane);
+                D const discrim = b * b - D{4} * c;
+                D const root = std::sqrt(discrim < D{} ? D{} : discrim);
+                D const t0 = (-b - root) / D{2}, t1 = (-b + root) / D{2};
+                bool const first = (t0 >= eps) & (t0 < t_max[lane]);
+                bool const second =
+                        (t0 < eps) & (t1 >= eps) & (t1 < t_max[lane]);
+                blocked[lane] = (discrim >= D{}) & (first | second);
+            }
+            for (std::size_t lane{}; lane < N; ++lane) {
+                blocked[lane] &= by.active[lane];
+            }
+            return blocked;
+        }
+
+      private:
+        /// The b c values for the quadratic for one lane of a packet
+        template<typename P>
+        static std::pair<D, D>
+                packet_b_c(P const &by, std::size_t const lane) {
+            D const fx = by.from[0][lane], fy = by.from[1][lane],
+                    fz = by.from[2][lane];
+            return {D{2}
+                            * (fx * by.direction[0][lane]
+                               + fy * by.direction[1][lane]
+                               + fz * by.direction[2][lane]),
+                    fx * fx + fy * fy + fz * fz - D{1}};
         }
     };
 
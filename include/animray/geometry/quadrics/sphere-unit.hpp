@@ -54,27 +54,38 @@ namespace animray {
         unit_sphere() : position{} {}
         unit_sphere(position_type p) : position{std::move(p)} {}
 
+        /// The bounding box of the sphere. Animated positions need the
+        /// parameters (e.g. a ray carrying a frame) to reduce against
+        template<typename... A>
+        bounding_box<D> bounds(A const &...a) const {
+            auto const c = reduce(position, a...);
+            return {{c.x() - D{1}, c.y() - D{1}, c.z() - D{1}},
+                    {c.x() + D{1}, c.y() + D{1}, c.z() + D{1}}};
+        }
+
         /// Returns a ray giving the intersection point and surface normal or
         /// null if no intersection occurs
         template<typename R, typename E>
         std::optional<intersection_type>
                 intersects(R by, const E epsilon) const {
-            by.from = by.from - reduce(position, by);
+            auto const centre = reduce(position, by);
+            by.from = by.from - centre;
             std::optional<intersection_type> hit(
                     origin.intersects(by, epsilon));
             if (hit) {
-                hit->from = hit->from + reduce(position, by);
+                hit->from = hit->from + centre;
                 return hit;
             } else {
                 return {};
             }
         }
 
-        /// Returns true if the ray hits the sphere
+        /// Returns true if the ray hits the sphere before `t_max`
         template<typename R, typename E>
-        bool occludes(R by, const E epsilon) const {
+        bool occludes(
+                R by, const E epsilon, D const t_max = unbounded<D>) const {
             by.from = by.from - reduce(position, by);
-            return origin.occludes(by, epsilon);
+            return origin.occludes(by, epsilon, t_max);
         }
     };
 
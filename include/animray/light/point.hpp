@@ -57,8 +57,11 @@ namespace animray {
             O illumination(observer);
             illumination.from = intersection.from;
             illumination.to(geometry);
+            // Only geometry between the surface and the light casts a shadow
+            local_coord_type const distance(
+                    (geometry - intersection.from).magnitude());
             if (not scene.geometry.occludes(
-                        illumination, epsilon<local_coord_type>)) {
+                        illumination, epsilon<local_coord_type>, distance)) {
                 return shader(
                         observer, illumination, intersection, superclass::color,
                         scene);
@@ -0,0 +1,290 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_MANDELBROT_PERTURBATION_HPP
+#define ANIMRAY_MANDELBROT_PERTURBATION_HPP
+#pragma once
+
+
+#include <animray/mandelbrot.hpp>
+#include <animray/maths/fixed-point.hpp>
+#include <complex>
+#include <memory>
+#include <vector>
+
+
+namespace animray::mandelbrot {
+
+
+    /**
+     * # Perturbation
+     *
+     * Past about 1e-15 the pixels are too close together for `double` and
+     * past about 1e-18 for `long double`. Rather than iterate every pixel
+     * with arbitrary precision, a single reference orbit `Z` is worked out
+     * for the centre of the image with a `fixed_point` that is precise
+     * enough for the zoom, and is then rounded to `double`. The orbit of
+     * each pixel is then followed as its (small) difference `d` from the
+     * reference:
+     *
+     *     d' = 2Zd + d² + dc
+     *
+     * where `dc` is the distance from the centre to the pixel. Only the
+     * differences need to be able to tell pixels apart, so `double` is
+     * good for pixels down to about 1e-300 apart. Going further would need
+     * the deltas to carry an extended exponent.
+     *
+     * A pixel whose orbit comes closer to zero than it is to the reference
+     * has lost the precision that the small difference gave it, which is
+     * what shows up as "glitches" in simple perturbation renderers. Rather
+     * than try to patch those pixels afterwards, the pixel is rebased: its
+     * full value becomes the difference and it restarts from the beginning
+     * of the reference orbit, where `Z` is zero. Pixels are rebased the
+     * same way when they outlast a reference orbit that escapes, so the
+     * one orbit serves the whole image.
+     */
+    struct reference_orbit {
+        std::vector<double> x, y;
+
+        /// The orbit of `(cx, cy)` starting at zero, with `fraction_limbs`
+        /// limbs of precision. It ends with the first point that escapes
+        /// or after `limit + 1` points
+        reference_orbit(
+                fixed_point const &cx,
+                fixed_point const &cy,
+                std::size_t const fraction_limbs,
+                std::size_t const limit) {
+            fixed_point zx{fraction_limbs}, zy{fraction_limbs};
+            x.reserve(limit + 1);
+            y.reserve(limit + 1);
+            while (true) {
+                double const dx = double(zx), dy = double(zy);
+                x.push_back(dx);
+                y.push_back(dy);
+                if (x.size() > limit or dx * dx + dy * dy >= 4) { break; }
+                fixed_point const x2 = zx * zx, y2 = zy * zy, xy = zx * zy;
+                zx = x2 - y2 + cx;
+                zy = xy + xy + cy;
+            }
+        }
+
+        /// The number of iterations before the point `(dcx, dcy)` away from
+        /// the reference escapes, counted the same way as `escape_times`.
+        /// The first `skip` iterations can be left out when the difference
+        /// `(dx, dy)` after them is already known. `skip` must be less
+        /// than both `limit` and the last point of the orbit
+        std::size_t escape_time(
+                double const dcx,
+                double const dcy,
+                std::size_t const limit,
+                std::size_t const skip = 0,
+                double dx = 0,
+                double dy = 0) const {
+            std::size_t const last = x.size() - 1;
+            for (std::size_t n = skip, m = skip; n != limit;) {
+                /// d' = (2Z + d)d + dc
+                double const tx = 2 * x[m] + dx, ty = 2 * y[m] + dy;
+                double const ndx = tx * dx - ty * dy + dcx;
+                dy = tx * dy + ty * dx + dcy;
+                dx = ndx;
+                ++m;
+                ++n;
+                double const wx = x[m] + dx, wy = y[m] + dy;
+                double const w2 = wx * wx + wy * wy;
+                if (w2 >= 4) { return n - 1; }
+                if (w2 < dx * dx + dy * dy or m == last) {
+                    dx = wx;
+                    dy = wy;
+                    m = 0;
+                }
+            }
+            return limit;
+        }
+    };
+
+
+    /**
+     * # Series approximation
+     *
+     * Near the start of the orbit the difference from the reference is
+     * still small enough to be a polynomial in `dc`:
+     *
+     *     d = A dc + B dc² + C dc³
+     *
+     * and the coefficients only depend on the reference, so they can be
+     * worked out once for the whole image:
+     *
+     *     A' = 2ZA + 1
+     *     B' = 2ZB + A²
+     *     C' = 2ZC + 2AB
+     *
+     * Every pixel then starts at iteration `skip` from the polynomial
+     * instead of at zero. A fourth coefficient `D' = 2ZD + 2AC + B²` is
+     * kept to bound the error of leaving it out. The polynomial is
+     * stepped on until, for the pixel furthest from the reference, either
+     * that error would be more than `series_tolerance` of the difference,
+     * or the pixel could have escaped or needed rebasing in the skipped
+     * iterations.
+     *
+     * At deep zooms the powers of `dc` underflow and the coefficients
+     * overflow a `double`, so each coefficient is kept multiplied by the
+     * matching power of the radius of the image. These stay about the
+     * size of the differences themselves.
+     */
+    constexpr double series_tolerance = 1e-12;
+
+
+    struct series_approximation {
+        /// The number of iterations that every pixel skips
+        std::size_t skip{};
+        /// The distance to the furthest pixel from the reference
+        double radius;
+        /// The coefficients scaled by `radius`, `radius²` and `radius³`
+        std::complex<double> a{}, b{}, c{};
+
+        /// Skip as many iterations of the reference as is safe for pixels
+        /// no further than `radius` from it
+        series_approximation(
+                reference_orbit const &orbit,
+                double const r,
+                std::size_t const limit)
+        : radius{r} {
+            std::complex<double> d{};
+            for (std::size_t n{}; n + 2 < orbit.x.size() and n + 1 < limit;
+                 ++n) {
+                std::complex<double> const z2{
+                        2 * orbit.x[n], 2 * orbit.y[n]};
+                auto const na = z2 * a + radius, nb = z2 * b + a * a,
+                           nc = z2 * c + 2.0 * a * b,
+                           nd = z2 * d + 2.0 * a * c + b * b;
+                double const difference =
+                        std::abs(na) + std::abs(nb) + std::abs(nc);
+                double const z = std::hypot(orbit.x[n + 1], orbit.y[n + 1]);
+                if (not(std::abs(nd) <= series_tolerance * difference)
+                    or z + difference >= 2 or z < 2 * difference) {
+                    break;
+                }
+                a = na;
+                b = nb;
+                c = nc;
+                d = nd;
+                skip = n + 1;
+            }
+        }
+
+        /// The difference from the reference after `skip` iterations
+        std::complex<double> operator()(std::complex<double> const dc) const {
+            auto const u = dc / radius;
+            return ((c * u + b) * u + a) * u;
+        }
+    };
+
+
+    /// The number of fraction bits needed to iterate the reference orbit
+    /// for pixels `per_pixel` apart
+    inline std::size_t reference_bits(double const per_pixel) {
+        return 64
+                + std::size_t(std::max(0.0, std::ceil(-std::log2(per_pixel))));
+    }
+
+
+    /// A film transformation functor implementing the mandelbrot with
+    /// perturbation around a reference orbit at the centre of the image.
+    /// Every pixel starts from the series approximation
+    template<typename F>
+    struct perturbation {
+        const typename F::size_type width, height;
+        const double diameter, per_pixel;
+        const std::size_t bits;
+        typedef std::function<typename F::color_type(unsigned int, std::size_t)>
+                colour_constructor;
+        colour_constructor cons;
+        /// Shared so that copies of the functor are cheap
+        std::shared_ptr<reference_orbit const> orbit;
+        /// The iterations that every pixel can skip
+        const series_approximation series;
+
+        perturbation(
+                typename F::size_type width,
+                typename F::size_type height,
+                fixed_point const &x,
+                fixed_point const &y,
+                double s,
+                std::size_t bits,
+                colour_constructor fn =
+                        [](unsigned int d, std::size_t bits) {
+                            // Scale to 0-255 range
+                            if (bits < 8) {
+                                return typename F::color_type(d << (8 - bits));
+                            } else {
+                                return typename F::color_type(d >> (bits - 8));
+                            }
+                        })
+        : width(width),
+          height(height),
+          diameter(s),
+          per_pixel(s / std::min(width, height)),
+          bits(bits),
+          cons(fn),
+          orbit(std::make_shared<reference_orbit>(
+                  x,
+                  y,
+                  fixed_point::limbs_for(reference_bits(per_pixel)),
+                  limit())),
+          series(*orbit,
+                 per_pixel * std::hypot(double(width), double(height)) / 2,
+                 limit()) {}
+
+        using result_type = typename F::color_type;
+        using arg1_type = typename F::size_type;
+        using arg2_type = typename F::size_type;
+
+        /// The most iterations counted for a pixel
+        std::size_t limit() const noexcept {
+            return (std::size_t{1} << bits) - 1u;
+        }
+
+        typename F::color_type operator()(
+                const typename F::size_type lx,
+                const typename F::size_type ly) const {
+            double const dx = (double(lx) - double(width) / 2) * per_pixel;
+            double const dy = (double(ly) - double(height) / 2) * per_pixel;
+            auto const start = series({dx, dy});
+            std::size_t const count = orbit->escape_time(
+                    dx, dy, limit(), series.skip, start.real(), start.imag());
+            unsigned int const counter = count < limit() ? count + 1 : 0;
+            return cons(counter, bits);
+        }
+
+        /// Calculate every pixel of the film
+        void fill(F &image) const {
+            for (typename F::size_type ly{}; ly != height; ++ly) {
+                for (typename F::size_type lx{}; lx != width; ++lx) {
+                    image.pixel(lx, ly) = (*this)(lx, ly);
+                }
+            }
+        }
+    };
+
+
+}
+
+
+#endif // ANIMRAY_MANDELBROT_PERTURBATION_HPP
@@ -25,6 +25,7 @@
 
 
 #include <animray/unit-vector.hpp>
+#include <animray/vec3.hpp>
 
 
 namespace animray {
@@ -44,6 +45,13 @@ namespace animray {
                 b.y() * c.z() - b.z() * c.y(), b.z() * c.x() - b.x() * c.z(),
                 b.x() * c.y() - b.y() * c.x());
     }
+    /// Cross product for non-homogeneous vectors
+    template<typename D>
+    vec3<D> cross(const vec3<D> &b, const vec3<D> &c) {
+        return vec3<D>(
+                b.y() * c.z() - b.z() * c.y(), b.z() * c.x() - b.x() * c.z(),
+                b.x() * c.y() - b.y() * c.x());
+    }
 
 
 }
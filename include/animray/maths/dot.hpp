@@ -25,6 +25,7 @@
 
 
 #include <animray/unit-vector.hpp>
+#include <animray/vec3.hpp>
 
 
 namespace animray {
@@ -50,6 +51,11 @@ namespace animray {
     D dot(const point3d<D> &d1, const point3d<D> &d2) {
         return d1.x() * d2.x() + d1.y() * d2.y() + d1.z() * d2.z();
     }
+    /// Dot product for non-homogeneous vectors
+    template<typename D>
+    D dot(const vec3<D> &d1, const vec3<D> &d2) {
+        return d1.x() * d2.x() + d1.y() * d2.y() + d1.z() * d2.z();
+    }
 
 
 }
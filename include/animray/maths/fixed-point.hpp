@@ -0,0 +1,262 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_MATHS_FIXED_POINT_HPP
+#define ANIMRAY_MATHS_FIXED_POINT_HPP
+#pragma once
+
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace animray {
+
+
+    /**
+     * # Fixed point numbers
+     *
+     * A signed two's complement number with a 32 bit integer part and a
+     * fraction made up of any number of 32 bit limbs. The number of limbs
+     * is picked when the number is made, so the precision can follow the
+     * zoom of an image rather than being fixed at compile time.
+     *
+     * Addition and subtraction are exact (they wrap on overflow of the
+     * integer part) and multiplication truncates the magnitude of the
+     * product. When two numbers of different precision are combined the
+     * result has the larger of the two.
+     */
+    class fixed_point {
+        /// Least significant limb first. The last limb is the integer part
+        std::vector<std::uint32_t> limbs;
+
+        bool negative() const noexcept { return limbs.back() >> 31; }
+
+        /// A copy with `fraction` limbs of fraction, dropping or adding
+        /// limbs at the least significant end
+        fixed_point resized(std::size_t const fraction) const {
+            fixed_point r{fraction};
+            std::size_t const have = fraction_limbs();
+            for (std::size_t index{}; index != limbs.size(); ++index) {
+                if (index + fraction >= have) {
+                    r.limbs[index + fraction - have] = limbs[index];
+                }
+            }
+            return r;
+        }
+
+        /// Divide the magnitude by a small number in place, rounding down
+        void divide(std::uint32_t const d) {
+            std::uint64_t remainder{};
+            for (std::size_t index = limbs.size(); index--;) {
+                std::uint64_t const n = (remainder << 32) | limbs[index];
+                limbs[index] = std::uint32_t(n / d);
+                remainder = n % d;
+            }
+        }
+
+      public:
+        /// Zero with `fraction` limbs of fraction
+        explicit fixed_point(std::size_t const fraction = 2)
+        : limbs(fraction + 1) {}
+        /// The value. Throws `std::out_of_range` unless the integer part
+        /// fits in 31 bits
+        fixed_point(long double const value, std::size_t const fraction)
+        : limbs(fraction + 1) {
+            long double m = std::abs(value);
+            if (not(m < 0x1p31L)) {
+                throw std::out_of_range{
+                        "Too large for a fixed point number: "
+                        + std::to_string(value)};
+            }
+            long double const whole = std::floor(m);
+            limbs.back() = std::uint32_t(whole);
+            m -= whole;
+            for (std::size_t index = fraction; index-- and m > 0;) {
+                m = std::ldexp(m, 32);
+                long double const part = std::floor(m);
+                limbs[index] = std::uint32_t(part);
+                m -= part;
+            }
+            if (value < 0) { *this = -*this; }
+        }
+        /// Parse a decimal number such as `-0.743643887037158704752191506`
+        /// or `1.5e-30`
+        fixed_point(std::string_view const text, std::size_t const fraction)
+        : limbs(fraction + 1) {
+            auto const invalid = [text]() {
+                return std::invalid_argument{
+                        "Not a decimal number: " + std::string{text}};
+            };
+            std::string_view number = text;
+            bool const minus = number.starts_with('-');
+            if (minus or number.starts_with('+')) { number.remove_prefix(1); }
+
+            /// The exponent moves the decimal point through the digits
+            auto const e = std::min(number.find_first_of("eE"), number.size());
+            long exponent{};
+            if (e != number.size()) {
+                auto power = number.substr(e + 1);
+                if (power.starts_with('+')) { power.remove_prefix(1); }
+                auto const end = power.data() + power.size();
+                auto const [last, error] =
+                        std::from_chars(power.data(), end, exponent);
+                if (power.empty() or error != std::errc{} or last != end) {
+                    throw invalid();
+                }
+            }
+            auto const mantissa = number.substr(0, e);
+            auto const dot = std::min(mantissa.find('.'), mantissa.size());
+            std::string digits{mantissa.substr(0, dot)};
+            if (dot != mantissa.size()) { digits += mantissa.substr(dot + 1); }
+            for (char const c : digits) {
+                if (c < '0' or c > '9') { throw invalid(); }
+            }
+
+            auto const too_large = [text]() {
+                return std::out_of_range{
+                        "Too large for a fixed point number: "
+                        + std::string{text}};
+            };
+            auto const leading =
+                    std::min(digits.find_first_not_of('0'), digits.size());
+            if (leading == digits.size()) { return; }
+
+            /// Digits after ten per limb are far below the last bit. The
+            /// integer part is signed, so it can't hold more than ten
+            /// digits, which is checked before any are added
+            long const point = std::max(
+                    long(dot) + exponent, -10 * long(limbs.size()));
+            if (point - long(leading) > 10) {
+                throw too_large();
+            } else if (point < 0) {
+                digits.insert(0, std::size_t(-point), '0');
+            } else if (std::size_t(point) > digits.size()) {
+                digits.append(std::size_t(point) - digits.size(), '0');
+            }
+            std::size_t const whole_digits = std::max(point, 0L);
+
+            /// The fraction is worked out from its last digit to its first,
+            /// adding each digit and then dividing by ten
+            for (std::size_t index = digits.size(); index > whole_digits;) {
+                limbs.back() += digits[--index] - '0';
+                divide(10);
+            }
+            std::uint64_t whole{};
+            for (std::size_t index{}; index != whole_digits; ++index) {
+                whole = whole * 10 + std::uint64_t(digits[index] - '0');
+                if (whole > std::numeric_limits<std::int32_t>::max()) {
+                    throw too_large();
+                }
+            }
+            limbs.back() = std::uint32_t(whole);
+            if (minus) { *this = -*this; }
+        }
+
+        /// The number of fraction limbs needed to hold `bits` bits of
+        /// fraction
+        static constexpr std::size_t limbs_for(std::size_t const bits) {
+            return (bits + 31) / 32;
+        }
+        /// The number of 32 bit limbs in the fraction
+        std::size_t fraction_limbs() const noexcept {
+            return limbs.size() - 1;
+        }
+
+        fixed_point operator-() const {
+            fixed_point r{*this};
+            std::uint64_t carry = 1;
+            for (auto &limb : r.limbs) {
+                carry += std::uint32_t(~limb);
+                limb = std::uint32_t(carry);
+                carry >>= 32;
+            }
+            return r;
+        }
+        fixed_point operator+(fixed_point const &b) const {
+            std::size_t const fraction =
+                    std::max(fraction_limbs(), b.fraction_limbs());
+            fixed_point r = resized(fraction);
+            fixed_point const o = b.resized(fraction);
+            std::uint64_t carry{};
+            for (std::size_t index{}; index != r.limbs.size(); ++index) {
+                carry += std::uint64_t(r.limbs[index]) + o.limbs[index];
+                r.limbs[index] = std::uint32_t(carry);
+                carry >>= 32;
+            }
+            return r;
+        }
+        fixed_point operator-(fixed_point const &b) const {
+            return *this + -b;
+        }
+        fixed_point operator*(fixed_point const &b) const {
+            std::size_t const fraction =
+                    std::max(fraction_limbs(), b.fraction_limbs());
+            bool const minus = negative() != b.negative();
+            fixed_point const x =
+                    negative() ? -resized(fraction) : resized(fraction);
+            fixed_point const y =
+                    b.negative() ? -b.resized(fraction) : b.resized(fraction);
+            std::size_t const n = fraction + 1;
+            std::vector<std::uint32_t> product(2 * n);
+            for (std::size_t i{}; i != n; ++i) {
+                std::uint64_t carry{};
+                for (std::size_t j{}; j != n; ++j) {
+                    carry += std::uint64_t(x.limbs[i]) * y.limbs[j]
+                            + product[i + j];
+                    product[i + j] = std::uint32_t(carry);
+                    carry >>= 32;
+                }
+                product[i + n] = std::uint32_t(carry);
+            }
+            fixed_point r{fraction};
+            std::copy(product.begin() + fraction,
+                      product.begin() + fraction + n, r.limbs.begin());
+            return minus ? -r : r;
+        }
+
+        /// The nearest `long double`, or near enough
+        explicit operator long double() const {
+            if (negative()) { return -static_cast<long double>(-*this); }
+            long double value{};
+            for (std::size_t index{}; index != limbs.size(); ++index) {
+                value += std::ldexp(
+                        static_cast<long double>(limbs[index]),
+                        32 * (int(index) - int(fraction_limbs())));
+            }
+            return value;
+        }
+        explicit operator double() const {
+            return double(static_cast<long double>(*this));
+        }
+    };
+
+
+}
+
+
+#endif // ANIMRAY_MATHS_FIXED_POINT_HPP
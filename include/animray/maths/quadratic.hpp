@@ -23,6 +23,8 @@
 #pragma once
 
 
+#include <animray/unbounded.hpp>
+
 #include <cmath>
 #include <optional>
 
@@ -30,15 +32,22 @@
 namespace animray {
 
 
-    /// Returns true if the quadratic has real solutions within the provided range
+    /// Returns true if the quadratic has a real solution that is at least
+    /// `range` and less than `limit`
     template<typename D>
-    bool quadratic_has_solution(D const, D const b, D const c, D const range) {
-        const D discriminant = b * b - D(4) * c;
+    bool quadratic_has_solution(
+            D const a,
+            D const b,
+            D const c,
+            D const range,
+            D const limit = unbounded<D>) {
+        const D discriminant = b * b - D(4) * a * c;
         if (discriminant < D(0)) return false;
         const D disc_root = std::sqrt(discriminant);
-        if (-b - disc_root >= range) return true;
-        if (-b + disc_root >= range) return true;
-        return false;
+        const D t0 = (-b - disc_root) / (D(2) * a);
+        if (t0 >= range) return t0 < limit;
+        const D t1 = (-b + disc_root) / (D(2) * a);
+        return t1 >= range and t1 < limit;
     }
 
 
@@ -24,6 +24,7 @@
 
 
 #include <animray/point3d.hpp>
+#include <animray/vec3.hpp>
 
 
 namespace animray {
@@ -125,6 +126,16 @@ namespace animray {
                     sum(((*this)[2] * v).array()),
                     sum(((*this)[3] * v).array()));
         }
+        /// Multiply by a non-homogeneous vector, which is treated as a
+        /// location
+        vec3<value_type> operator*(vec3<value_type> const &v) const {
+            auto const &m = superclass::array;
+            value_type const x = v.x(), y = v.y(), z = v.z();
+            value_type const w = m[12] * x + m[13] * y + m[14] * z + m[15];
+            return {(m[0] * x + m[1] * y + m[2] * z + m[3]) / w,
+                    (m[4] * x + m[5] * y + m[6] * z + m[7]) / w,
+                    (m[8] * x + m[9] * y + m[10] * z + m[11]) / w};
+        }
 
         /// Multiply by another matrix
         matrix &operator*=(const matrix &r) {
@@ -24,8 +24,10 @@
 
 
 #include <animray/affine.hpp>
+#include <animray/affine-matrix.hpp>
+#include <animray/geometry/bounding-box.hpp>
 #include <animray/ray.hpp>
-#include <animray/matrix.hpp>
+#include <animray/ray-packet.hpp>
 #include <optional>
 
 
@@ -54,8 +56,8 @@ namespace animray {
         /// Apply a transformation
         template<typename T>
         transformable &operator()(const T &t) {
-            forward = t.backward() * forward;
-            backward *= t.forward();
+            forward = M(t.backward()) * forward;
+            backward *= M(t.forward());
             return *this;
         }
     };
@@ -65,7 +67,8 @@ namespace animray {
     template<
             typename O,
             typename I = typename O::intersection_type,
-            typename T = transformable<matrix<typename O::local_coord_type>>>
+            typename T =
+                    transformable<affine_matrix<typename O::local_coord_type>>>
     class movable : private T {
         using superclass = T;
 
@@ -98,6 +101,12 @@ namespace animray {
             return *this;
         }
 
+        /// The bounds of the instance after it has been moved
+        template<typename... P>
+        bounding_box<local_coord_type> bounds(P const &...p) const {
+            return instance.bounds(p...).transform(superclass::backward);
+        }
+
         /// Ray intersection
         template<typename R, typename E>
         std::optional<intersection_type>
@@ -111,10 +120,61 @@ namespace animray {
             }
         }
 
-        /// Occlusion check
+        /// Occlusion check for anything closer than `t_max`. The distance
+        /// is measured in the instance's own co-ordinate space
         template<typename R>
-        bool occludes(const R &by, const local_coord_type epsilon) const {
-            return instance.occludes(by * superclass::forward, epsilon);
+        bool occludes(
+                const R &by,
+                const local_coord_type epsilon,
+                local_coord_type const t_max =
+                        unbounded<local_coord_type>) const {
+            return instance.occludes(
+                    by * superclass::forward, epsilon,
+                    transform_distance(by, superclass::forward, t_max));
+        }
+
+        /// Update the lanes of `closest` for which the instance is nearer.
+        /// The packet is moved into the instance's space lane by lane
+        template<typename PD, std::size_t N, typename E>
+        void intersects(
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                packet_intersection<intersection_type, N> &closest) const {
+            auto const local = by * superclass::forward;
+            packet_intersection<typename O::intersection_type, N> hits;
+            for (std::size_t lane{}; lane < N; ++lane) {
+                if (by.active[lane]) {
+                    hits.distance[lane] = transform_distance(
+                            by[lane], superclass::forward,
+                            closest.distance[lane]);
+                }
+            }
+            instance.intersects(local, epsilon, hits);
+            for (std::size_t lane{}; lane < N; ++lane) {
+                if (hits.hit[lane]) {
+                    closest.hit[lane] = *hits.hit[lane] * superclass::backward;
+                    closest.distance[lane] =
+                            (closest.hit[lane]->from - by[lane].from)
+                                    .magnitude();
+                }
+            }
+        }
+
+        /// The active lanes that the instance blocks before their `t_max`
+        template<typename PD, std::size_t N, typename E>
+        lane_mask<N> occludes(
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                std::array<local_coord_type, N> const &t_max) const {
+            std::array<local_coord_type, N> local_t_max;
+            for (std::size_t lane{}; lane < N; ++lane) {
+                local_t_max[lane] = by.active[lane]
+                        ? transform_distance(
+                                by[lane], superclass::forward, t_max[lane])
+                        : t_max[lane];
+            }
+            return instance.occludes(
+                    by * superclass::forward, epsilon, local_t_max);
         }
 
         /// Allow the instance to be used as a camera
@@ -122,6 +182,13 @@ namespace animray {
         intersection_type operator()(F x, F y) const {
             return instance(x, y) * superclass::backward;
         }
+
+        /// Allow the instance to be used as a camera that generates a
+        /// packet of rays
+        template<std::size_t W, std::size_t H = W, typename F>
+        auto packet(F x, F y) const {
+            return instance.template packet<W, H>(x, y) * superclass::backward;
+        }
     };
 
 
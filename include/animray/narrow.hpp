@@ -18,6 +18,9 @@
 */
 
 
+#pragma once
+
+
 #include <limits>
 #include <felspar/exceptions/underflow_error.hpp>
 #include <felspar/exceptions/overflow_error.hpp>
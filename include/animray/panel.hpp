@@ -45,8 +45,8 @@ namespace animray {
               return fn(x + ox, y + oy);
           }) {}
 
-        /// Return a non-mutable row from the inner film
-        const typename F::column_type &operator[](const size_type c) const {
+        /// Return a non-mutable column from the inner film
+        typename F::const_column_type operator[](const size_type c) const {
             return inner_film[c];
         }
     };
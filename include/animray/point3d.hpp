@@ -118,11 +118,15 @@ namespace animray {
         /// Unary minus
         point3d operator-() const { return (*this) * -1; }
 
-        /// Return the homogeneous with unit length
+        /// Return the homogeneous with unit length. The unit vector keeps
+        /// the same components and stores the length in `w`, which must
+        /// take account of any `w` this has
         unit_vector<value_type> unit() const {
+            auto const &a = superclass::array;
+            value_type const length =
+                    std::sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
             return unit_vector<value_type>(
-                    superclass::array[0], superclass::array[1],
-                    superclass::array[2], magnitude());
+                    a[0], a[1], a[2], a[3] < value_type{} ? -length : length);
         }
 
         /// The dot product of the location as vector with itself
@@ -0,0 +1,159 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_RAY_PACKET_HPP
+#define ANIMRAY_RAY_PACKET_HPP
+#pragma once
+
+
+#include <animray/ray.hpp>
+#include <animray/unbounded.hpp>
+
+#include <array>
+#include <optional>
+
+
+namespace animray {
+
+
+    /**
+     * # Ray packets
+     *
+     * A packet holds `N` rays with each co-ordinate of the starts and
+     * directions held in its own array so that geometry can test all of
+     * the rays in one pass of a loop. Rays from neighbouring pixels go in
+     * much the same direction, so they tend to strike the same geometry.
+     *
+     * Only the lanes set in `active` are used. Geometry that supports
+     * packets has two extra overloads:
+     *
+     * * `intersects(packet, epsilon, closest)` updates the lanes of the
+     *   `packet_intersection` for which the geometry is nearer than what
+     *   has been found so far.
+     * * `occludes(packet, epsilon, t_max)` returns the mask of the active
+     *   lanes that are blocked before their `t_max`.
+     */
+
+
+    /// Marks which lanes of a packet are in use
+    template<std::size_t N>
+    using lane_mask = std::array<bool, N>;
+
+    /// True if any lane is set
+    template<std::size_t N>
+    bool any(lane_mask<N> const &m) {
+        bool r{false};
+        for (auto const l : m) { r |= l; }
+        return r;
+    }
+    /// The lanes set in either mask
+    template<std::size_t N>
+    lane_mask<N> either(lane_mask<N> a, lane_mask<N> const &b) {
+        for (std::size_t lane{}; lane < N; ++lane) { a[lane] |= b[lane]; }
+        return a;
+    }
+
+
+    /// A packet of `N` rays
+    template<typename D, std::size_t N>
+    class ray_packet {
+      public:
+        /// The value type of the rays
+        using local_coord_type = D;
+        /// The type of a single ray in the packet
+        using ray_type = ray<D>;
+        /// One value per lane
+        using lane_type = std::array<D, N>;
+        /// The mask of lanes
+        using mask_type = lane_mask<N>;
+        /// The number of rays in the packet
+        static constexpr std::size_t lanes = N;
+
+        /// Construct a packet with no active lanes
+        ray_packet() = default;
+
+        /// The starts of the rays, one array per axis
+        std::array<lane_type, 3> from{};
+        /// The unit directions of the rays, one array per axis
+        std::array<lane_type, 3> direction{};
+        /// The lanes which hold a ray
+        mask_type active{};
+
+        /// Place a ray in a lane
+        void set(std::size_t const lane, ray_type const &r) {
+            from[0][lane] = r.from.x();
+            from[1][lane] = r.from.y();
+            from[2][lane] = r.from.z();
+            direction[0][lane] = r.direction.x();
+            direction[1][lane] = r.direction.y();
+            direction[2][lane] = r.direction.z();
+            active[lane] = true;
+        }
+
+        /// The ray in a lane
+        ray_type operator[](std::size_t const lane) const {
+            return ray_type{
+                    typename ray_type::end_type{
+                            from[0][lane], from[1][lane], from[2][lane]},
+                    typename ray_type::direction_type{
+                            direction[0][lane], direction[1][lane],
+                            direction[2][lane]}};
+        }
+
+        /// Transform each active ray by a matrix
+        template<typename M>
+        ray_packet operator*(const M &right) const {
+            ray_packet res;
+            for (std::size_t lane{}; lane < N; ++lane) {
+                if (active[lane]) { res.set(lane, (*this)[lane] * right); }
+            }
+            return res;
+        }
+    };
+
+
+    /// The closest intersection found so far for each lane of a packet
+    template<typename I, std::size_t N>
+    struct packet_intersection {
+        /// The type of the intersection
+        using intersection_type = I;
+        /// The value type of the distances
+        using local_coord_type = typename I::local_coord_type;
+
+        /// Start with nothing struck
+        packet_intersection() {
+            distance.fill(unbounded<local_coord_type>);
+        }
+        /// Start with the distances limited, but nothing struck
+        explicit packet_intersection(
+                std::array<local_coord_type, N> const &limit)
+        : distance{limit} {}
+
+        /// How far along the ray the closest intersection is
+        std::array<local_coord_type, N> distance;
+        /// The closest intersection in each lane
+        std::array<std::optional<intersection_type>, N> hit;
+    };
+
+
+}
+
+
+#endif // ANIMRAY_RAY_PACKET_HPP
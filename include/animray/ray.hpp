@@ -23,8 +23,10 @@
 #pragma once
 
 
-#include <animray/matrix.hpp>
+#include <animray/affine-matrix.hpp>
+#include <animray/unbounded.hpp>
 #include <animray/unit-vector.hpp>
+#include <animray/vec3.hpp>
 
 
 namespace animray {
@@ -46,13 +48,13 @@ namespace animray {
         ray() = default;
         /// Construct a line between two locations
         ray(const end_type &from, const end_type &to)
-        : from(from), direction(to - from) {}
+        : from(from), direction((to - from).unit()) {}
         /// Construct a line from a location in the specified direction
         ray(const end_type &from, const direction_type &dir)
         : from(from), direction(dir) {}
         /// Construct a follow on ray between two locations
         ray(const ray &, const end_type &from, const end_type &to)
-        : from(from), direction(to - from) {}
+        : from(from), direction((to - from).unit()) {}
         /// Construct a follow on ray from a location in the specified direction
         ray(const ray &, const end_type &from, const direction_type &dir)
         : from(from), direction(dir) {}
@@ -63,7 +65,9 @@ namespace animray {
         direction_type direction;
 
         /// Set a point the ray must go through
-        void to(const end_type &t) { direction = direction_type{t - from}; }
+        void to(const end_type &t) {
+            direction = direction_type{(t - from).unit()};
+        }
 
         /// Return a point somewhere along the line
         end_type ends(local_coord_type distance = local_coord_type(1)) const {
@@ -95,11 +99,59 @@ namespace animray {
             res *= right;
             return res;
         }
+
+        /// Transform a ray by an affine matrix. The direction only needs
+        /// the linear part of the transform
+        template<typename MD>
+        ray &operator*=(const affine_matrix<MD> &right) {
+            from = right * from;
+            direction = direction_type{right.direction(direction).unit()};
+            return *this;
+        }
+
+        /// Multiply
+        template<typename MD>
+        ray operator*(const affine_matrix<MD> &right) const {
+            ray res(*this);
+            res *= right;
+            return res;
+        }
     };
 
 
     template<typename V>
     ray(point3d<V>, point3d<V>) -> ray<V, point3d<V>>;
+    template<typename V>
+    ray(vec3<V>, vec3<V>) -> ray<V, vec3<V>, unit_vec3<V>>;
+
+
+    /// Convert a distance along the ray into the distance along the same
+    /// ray after it has been transformed by the matrix. An `unbounded`
+    /// distance stays unbounded
+    template<typename R, typename MD>
+    typename R::local_coord_type transform_distance(
+            R const &by,
+            matrix<MD> const &m,
+            typename R::local_coord_type const distance) {
+        using D = typename R::local_coord_type;
+        if (distance == unbounded<D>) {
+            return distance;
+        } else {
+            return D((m * by.ends(distance) - m * by.from).magnitude());
+        }
+    }
+    template<typename R, typename MD>
+    typename R::local_coord_type transform_distance(
+            R const &by,
+            affine_matrix<MD> const &m,
+            typename R::local_coord_type const distance) {
+        using D = typename R::local_coord_type;
+        if (distance == unbounded<D>) {
+            return distance;
+        } else {
+            return D(m.direction(by.direction).magnitude() * distance);
+        }
+    }
 
 
     /// Output to a stream
@@ -25,7 +25,9 @@
 
 #include <animray/epsilon.hpp>
 #include <animray/emission.hpp>
+#include <animray/ray-packet.hpp>
 
+#include <array>
 #include <optional>
 #include <utility>
 
@@ -80,6 +82,29 @@ namespace animray {
                 return background;
             }
         }
+
+        /// Work out the light returned along each ray of a packet. The
+        /// geometry is struck by the whole packet, but the shading is done
+        /// one lane at a time. Lanes that aren't active get the background
+        template<typename D, std::size_t N>
+        std::array<color_type, N>
+                operator()(ray_packet<D, N> const &observer) const {
+            packet_intersection<intersection_type, N> closest;
+            geometry.intersects(observer, epsilon<local_coord_type>, closest);
+            std::array<color_type, N> colours;
+            for (std::size_t lane{}; lane < N; ++lane) {
+                if (closest.hit[lane]) {
+                    auto const ray = observer[lane];
+                    colours[lane] =
+                            color_type(light(ray, *closest.hit[lane], *this))
+                            + emission<color_type>(
+                                    ray, *closest.hit[lane], *this);
+                } else {
+                    colours[lane] = background;
+                }
+            }
+            return colours;
+        }
     };
 
     template<typename G, typename L, typename C>
@@ -26,7 +26,9 @@
 #include <animray/emission.hpp>
 #include <animray/functional/zip.hpp>
 #include <animray/intersection.hpp>
+#include <animray/ray-packet.hpp>
 #include <animray/shader.hpp>
+#include <animray/unbounded.hpp>
 
 #include <optional>
 
@@ -99,6 +101,12 @@ namespace animray {
             return *this;
         }
 
+        /// The bounds of the underlying geometry
+        template<typename... P>
+        auto bounds(P const &...p) const {
+            return geometry.bounds(p...);
+        }
+
         /// Calculate the intersection of the ray on the instance
         template<typename R, typename E>
         std::optional<intersection_type>
@@ -112,10 +120,41 @@ namespace animray {
             }
         }
 
-        /// Calculate whether this object occludes the ray or not
+        /// Calculate whether this object occludes the ray before `t_max`
         template<typename R>
-        bool occludes(const R &by, const local_coord_type epsilon) const {
-            return geometry.occludes(by, epsilon);
+        bool occludes(
+                const R &by,
+                const local_coord_type epsilon,
+                local_coord_type const t_max =
+                        unbounded<local_coord_type>) const {
+            return geometry.occludes(by, epsilon, t_max);
+        }
+
+        /// Update the lanes of `closest` for which the geometry is nearer
+        template<typename PD, std::size_t N, typename E>
+        void intersects(
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                packet_intersection<intersection_type, N> &closest) const {
+            packet_intersection<typename O::intersection_type, N> hits{
+                    closest.distance};
+            geometry.intersects(by, epsilon, hits);
+            for (std::size_t lane{}; lane < N; ++lane) {
+                if (hits.hit[lane]) {
+                    closest.distance[lane] = hits.distance[lane];
+                    closest.hit[lane] =
+                            intersection_type(*hits.hit[lane], surfaces);
+                }
+            }
+        }
+
+        /// The active lanes that the geometry blocks before their `t_max`
+        template<typename PD, std::size_t N, typename E>
+        lane_mask<N> occludes(
+                ray_packet<PD, N> const &by,
+                const E epsilon,
+                std::array<local_coord_type, N> const &t_max) const {
+            return geometry.occludes(by, epsilon, t_max);
         }
     };
 
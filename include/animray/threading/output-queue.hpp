@@ -0,0 +1,133 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_THREADING_OUTPUT_QUEUE_HPP
+#define ANIMRAY_THREADING_OUTPUT_QUEUE_HPP
+#pragma once
+
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+
+namespace animray::threading {
+
+
+    /**
+     * # Output queue
+     *
+     * Runs jobs one at a time, in the order they were pushed, on a thread of
+     * its own. This is meant for encoding and writing out frames while the
+     * next frame renders.
+     *
+     * At most `capacity` jobs can be waiting or running at once. `push`
+     * blocks until there is room, which bounds the number of frames held
+     * in memory when writing them out is slower than rendering them.
+     *
+     * An exception thrown by a job is kept and rethrown by the next call to
+     * `push` or `flush`. The destructor runs every job still queued.
+     */
+    class output_queue {
+        std::size_t const capacity;
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::deque<std::function<void()>> jobs;
+        bool running = false, stopping = false;
+        std::exception_ptr error;
+        std::thread worker;
+
+        void run() {
+            std::unique_lock lock{mutex};
+            while (true) {
+                changed.wait(lock, [this]() {
+                    return stopping or not jobs.empty();
+                });
+                if (jobs.empty()) { return; }
+                auto job = std::move(jobs.front());
+                jobs.pop_front();
+                running = true;
+                lock.unlock();
+                std::exception_ptr failed;
+                try {
+                    job();
+                } catch (...) {
+                    failed = std::current_exception();
+                }
+                lock.lock();
+                if (failed and not error) { error = failed; }
+                running = false;
+                changed.notify_all();
+            }
+        }
+
+        void rethrow(std::unique_lock<std::mutex> &lock) {
+            if (error) {
+                auto const failed = std::exchange(error, nullptr);
+                lock.unlock();
+                std::rethrow_exception(failed);
+            }
+        }
+
+      public:
+        explicit output_queue(std::size_t const c = 2)
+        : capacity{std::max<std::size_t>(c, 1)}, worker{[this]() { run(); }} {}
+        ~output_queue() {
+            {
+                std::lock_guard lock{mutex};
+                stopping = true;
+            }
+            changed.notify_all();
+            worker.join();
+        }
+
+        output_queue(output_queue const &) = delete;
+        output_queue &operator=(output_queue const &) = delete;
+
+        /// Queue a job, waiting first until there is room for it
+        void push(std::function<void()> job) {
+            std::unique_lock lock{mutex};
+            changed.wait(lock, [this]() {
+                return jobs.size() + (running ? 1 : 0) < capacity;
+            });
+            rethrow(lock);
+            jobs.push_back(std::move(job));
+            changed.notify_all();
+        }
+
+        /// Wait until every queued job has finished
+        void flush() {
+            std::unique_lock lock{mutex};
+            changed.wait(
+                    lock, [this]() { return jobs.empty() and not running; });
+            rethrow(lock);
+        }
+    };
+
+
+}
+
+
+#endif // ANIMRAY_THREADING_OUTPUT_QUEUE_HPP
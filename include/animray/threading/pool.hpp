@@ -0,0 +1,208 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_THREADING_POOL_HPP
+#define ANIMRAY_THREADING_POOL_HPP
+#pragma once
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+namespace animray::threading {
+
+
+    /**
+     * # Thread pool
+     *
+     * A fixed set of worker threads that lives as long as the pool does, so
+     * work can be handed to it frame after frame without starting threads
+     * each time. Every worker has its own deque of jobs and takes work from
+     * the front of it. A worker whose deque is empty steals from the back of
+     * the others.
+     *
+     * Jobs queued from one of the pool's own workers go on the front of that
+     * worker's deque, so nested work (like the two halves of a BVH split) is
+     * picked up next by the thread that made it. Jobs queued from any other
+     * thread are dealt out to the back of the deques in turn, which means
+     * the workers run them roughly in the order they were queued, and idle
+     * workers steal the most recently queued ones.
+     *
+     * A thread that calls `wait` runs queued jobs until its result is ready.
+     * Jobs may therefore wait on jobs that they queued without running the
+     * pool out of threads.
+     */
+    class pool {
+        struct queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> jobs;
+        };
+        std::vector<std::unique_ptr<queue>> queues;
+        std::atomic<std::size_t> queued{}, next_queue{};
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+        bool stopping = false;
+        std::vector<std::thread> workers;
+
+        /// The pool and worker index for the current thread. Threads that
+        /// are not workers have no owner
+        struct worker_identity {
+            pool const *owner;
+            std::size_t index;
+        };
+        static inline thread_local worker_identity self{nullptr, 0};
+
+        void work(std::size_t const index) {
+            self = {this, index};
+            while (true) {
+                if (run_one()) { continue; }
+                std::unique_lock lock{sleep_mutex};
+                wake.wait(lock, [this]() { return stopping or queued > 0; });
+                if (stopping and queued == 0) { return; }
+            }
+        }
+
+      public:
+        /// Start `threads` worker threads. There is always at least one
+        explicit pool(std::size_t const threads =
+                              std::thread::hardware_concurrency()) {
+            std::size_t const count = std::max<std::size_t>(threads, 1);
+            queues.reserve(count);
+            for (std::size_t index{}; index != count; ++index) {
+                queues.push_back(std::make_unique<queue>());
+            }
+            workers.reserve(count);
+            for (std::size_t index{}; index != count; ++index) {
+                workers.emplace_back([this, index]() { work(index); });
+            }
+        }
+        /// Runs all of the jobs that are still queued before the workers
+        /// are stopped
+        ~pool() {
+            {
+                std::lock_guard lock{sleep_mutex};
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto &worker : workers) { worker.join(); }
+        }
+
+        pool(pool const &) = delete;
+        pool &operator=(pool const &) = delete;
+
+        /// The number of worker threads
+        std::size_t size() const noexcept { return workers.size(); }
+        /// The number of jobs waiting for a thread
+        std::size_t queued_jobs() const noexcept { return queued; }
+
+        /// Queue a job. Nothing can see the job's result, so it must not
+        /// throw
+        void post(std::function<void()> job) {
+            /// The job is counted before a worker can see it, otherwise one
+            /// could run it and take the count below zero
+            {
+                std::lock_guard lock{sleep_mutex};
+                ++queued;
+            }
+            try {
+                if (self.owner == this) {
+                    auto &q = *queues[self.index];
+                    std::lock_guard lock{q.mutex};
+                    q.jobs.push_front(std::move(job));
+                } else {
+                    auto &q = *queues[next_queue++ % queues.size()];
+                    std::lock_guard lock{q.mutex};
+                    q.jobs.push_back(std::move(job));
+                }
+            } catch (...) {
+                --queued;
+                throw;
+            }
+            wake.notify_one();
+        }
+
+        /// Queue a job and return a future for its result. Any exception
+        /// the job throws is stored in the future
+        template<typename F>
+        auto submit(F f) -> std::future<std::invoke_result_t<F &>> {
+            using result_type = std::invoke_result_t<F &>;
+            auto task = std::make_shared<std::packaged_task<result_type()>>(
+                    std::move(f));
+            auto result = task->get_future();
+            post([task = std::move(task)]() { (*task)(); });
+            return result;
+        }
+
+        /// Run a single queued job on the calling thread. Returns `false` if
+        /// there was nothing to run
+        bool run_one() {
+            bool const mine = (self.owner == this);
+            std::size_t const start = mine ? self.index : 0;
+            for (std::size_t offset{}; offset != queues.size(); ++offset) {
+                auto &q = *queues[(start + offset) % queues.size()];
+                std::function<void()> job;
+                {
+                    std::lock_guard lock{q.mutex};
+                    if (q.jobs.empty()) { continue; }
+                    if (mine and offset == 0) {
+                        job = std::move(q.jobs.front());
+                        q.jobs.pop_front();
+                    } else {
+                        job = std::move(q.jobs.back());
+                        q.jobs.pop_back();
+                    }
+                }
+                --queued;
+                job();
+                return true;
+            }
+            return false;
+        }
+
+        /// Run queued jobs until the future is ready and then return its
+        /// value
+        template<typename R>
+        R wait(std::future<R> result) {
+            while (result.wait_for(std::chrono::seconds{})
+                   != std::future_status::ready) {
+                if (not run_one()) {
+                    result.wait_for(std::chrono::microseconds{100});
+                }
+            }
+            return result.get();
+        }
+    };
+
+
+}
+
+
+#endif // ANIMRAY_THREADING_POOL_HPP
@@ -24,108 +24,280 @@
 
 
 #include <animray/film.hpp>
-#include <animray/panel.hpp>
+#include <animray/threading/pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
 #include <future>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <vector>
 
 
 namespace animray::threading {
 
 
-    namespace detail {
-        /// Calculate the greatest common denominator
-        template<typename S>
-        S gcd(S a, S b) {
-            while (b != 0) {
-                S t = b;
-                b = a % b;
-                a = t;
-            }
-            return a;
-        }
-        /// Calculate the next power of 2
-        template<typename S>
-        S bigestodd(S n) {
-            while ((n & 1) == 0 && n > S(20)) { n /= 2; }
-            return n;
-        }
-    }
-
-
-    /// Progress tracking for sub-panel rendering
+    /**
+     * # Sub-panel rendering
+     *
+     * The frame is cut into square tiles sized so that each thread gets
+     * about `tiles_per_thread` of them, whatever the resolution. Tiles on
+     * the right and top edges are clipped to the frame. `order` lists the
+     * tiles spiralling out from the centre of the frame, which is the order
+     * they are handed to the threads.
+     *
+     * The time taken by each finished tile is measured. A tile that is
+     * still being rendered after the average tile time, while threads are
+     * waiting for work, has its remaining rows split off into a new job so
+     * that a few expensive tiles cannot leave the other threads idle.
+     *
+     * The function given to `sub_panel` is normally called for each pixel
+     * with its co-ordinates. It may instead take a `film::region_view` and
+     * fill in the whole tile, which suits renderers that share work
+     * between neighbouring pixels. Those tiles can't be split once they
+     * have started.
+     */
     class sub_panel_progress {
-        std::size_t pdiv;
-
       public:
-        sub_panel_progress(std::size_t const w, std::size_t const h)
-        : pdiv{detail::bigestodd(detail::gcd(w, h))},
-          panel_size_x{w / pdiv},
-          panel_size_y{h / pdiv},
-          panel_count_x{w / panel_size_x},
-          panel_count_y{h / panel_size_y},
-          count_limit{panel_count_x * panel_count_y} {}
+        /// The number of tiles aimed for per thread
+        static constexpr std::size_t tiles_per_thread = 16;
+        /// Tile sizes are a multiple of this
+        static constexpr std::size_t tile_alignment = 8;
+
+        sub_panel_progress(
+                std::size_t const w,
+                std::size_t const h,
+                std::size_t const threads = std::thread::hardware_concurrency())
+        : panel_size_x{std::min(w, tile_size(w, h, threads))},
+          panel_size_y{std::min(h, tile_size(w, h, threads))},
+          panel_count_x{(w + panel_size_x - 1) / panel_size_x},
+          panel_count_y{(h + panel_size_y - 1) / panel_size_y},
+          count_limit{panel_count_x * panel_count_y},
+          width{w},
+          height{h} {
+            order.resize(count_limit);
+            std::iota(order.begin(), order.end(), std::size_t{});
+            auto const ring = [this](std::size_t const index) {
+                double const x = centre(index % panel_count_x, panel_size_x,
+                                        width),
+                             y = centre(index / panel_count_x, panel_size_y,
+                                        height);
+                return std::pair{
+                        std::round(std::max(
+                                std::abs(x) / panel_size_x,
+                                std::abs(y) / panel_size_y)),
+                        std::atan2(y, x)};
+            };
+            std::stable_sort(
+                    order.begin(), order.end(),
+                    [&](std::size_t const l, std::size_t const r) {
+                        return ring(l) < ring(r);
+                    });
+        }
 
         std::size_t panel_size_x, panel_size_y, panel_count_x, panel_count_y,
-                count_limit;
+                count_limit, width, height;
+        /// The tiles in the order they are to be rendered
+        std::vector<std::size_t> order;
+        /// The number of tiles completed
         std::atomic<std::uint64_t> count{};
+
+        /// The area covered by a tile
+        template<typename E>
+        E panel(std::size_t const index) const {
+            std::size_t const x = panel_size_x * (index % panel_count_x),
+                              y = panel_size_y * (index / panel_count_x);
+            return {x, y, std::min(x + panel_size_x, width) - 1,
+                    std::min(y + panel_size_y, height) - 1};
+        }
+
+      private:
+        static std::size_t tile_size(
+                std::size_t const w,
+                std::size_t const h,
+                std::size_t const threads) {
+            std::size_t const tiles =
+                    std::max<std::size_t>(threads, 1) * tiles_per_thread;
+            auto const edge = std::size_t(std::sqrt(double(w * h) / tiles));
+            return std::max(
+                    tile_alignment,
+                    (edge + tile_alignment / 2) / tile_alignment
+                            * tile_alignment);
+        }
+        /// The centre of a tile relative to the centre of the frame
+        static double centre(
+                std::size_t const tile,
+                std::size_t const size,
+                std::size_t const extent) {
+            double const lower = double(tile * size);
+            double const upper = double(std::min(lower + size, double(extent)));
+            return (lower + upper - extent) / 2;
+        }
     };
 
 
-    /// A mechanism whereby the frame is rendered in a number of sub-panels
+    namespace detail {
+        /// The state shared by all of the jobs rendering a frame
+        template<typename film_type, typename Fn>
+        struct sub_panel_frame {
+            sub_panel_frame(
+                    pool &w,
+                    sub_panel_progress &p,
+                    typename film_type::size_type const width,
+                    typename film_type::size_type const height,
+                    Fn f)
+            : workers{w},
+              progress{p},
+              image{width, height},
+              fn{std::move(f)},
+              remaining{p.count_limit},
+              pieces(p.count_limit) {
+                for (auto &count : pieces) { count = 1; }
+            }
+
+            using size_type = typename film_type::size_type;
+            using extents_type = typename film_type::extents_type;
+            /// True if `fn` fills in a whole tile itself
+            static constexpr bool renders_regions = std::is_invocable_v<
+                    Fn &, typename film_type::region_view const &>;
+
+            pool &workers;
+            sub_panel_progress &progress;
+            film_type image;
+            Fn fn;
+            /// Jobs that have not yet finished
+            std::atomic<std::size_t> remaining;
+            /// Jobs for each tile that have not yet finished
+            std::vector<std::atomic<std::uint32_t>> pieces;
+            /// Time spent on finished tiles
+            std::atomic<std::uint64_t> tile_time{}, tiles_timed{};
+            std::atomic<bool> failed{};
+            std::exception_ptr error;
+            std::promise<film_type> result;
+
+            /// Render rows `top` up to (not including) `end` of the tile,
+            /// splitting off the rows not yet started if this is taking too
+            /// long
+            static void render(
+                    std::shared_ptr<sub_panel_frame> const &self,
+                    std::size_t const tile,
+                    size_type const top,
+                    size_type end) {
+                auto &me = *self;
+                std::chrono::nanoseconds taken{};
+                if (not me.failed) {
+                    try {
+                        auto const area =
+                                me.progress.template panel<extents_type>(tile);
+                        auto const started = std::chrono::steady_clock::now();
+                        if constexpr (renders_regions) {
+                            me.fn(me.image.region(extents_type{
+                                    area.lower_left.x, top, area.top_right.x,
+                                    end - 1}));
+                            taken = std::chrono::steady_clock::now() - started;
+                        } else {
+                            for (size_type y = top; y < end; ++y) {
+                                me.image.region(extents_type{
+                                                        area.lower_left.x, y,
+                                                        area.top_right.x, y})
+                                        .fill(me.fn);
+                                taken = std::chrono::steady_clock::now()
+                                        - started;
+                                if (end - y > 2 and me.too_slow(taken)) {
+                                    size_type const middle =
+                                            y + 1 + (end - y - 1) / 2;
+                                    ++me.remaining;
+                                    ++me.pieces[tile];
+                                    me.workers.post(
+                                            [self, tile, middle, end]() {
+                                                render(self, tile, middle,
+                                                       end);
+                                            });
+                                    end = middle;
+                                }
+                            }
+                        }
+                    } catch (...) {
+                        if (not me.failed.exchange(true)) {
+                            me.error = std::current_exception();
+                        }
+                    }
+                }
+                me.tile_time += taken.count();
+                if (--me.pieces[tile] == 0) {
+                    ++me.tiles_timed;
+                    ++me.progress.count;
+                }
+                if (--me.remaining == 0) {
+                    if (me.error) {
+                        me.result.set_exception(me.error);
+                    } else {
+                        me.result.set_value(std::move(me.image));
+                    }
+                }
+            }
+
+            /// A piece is too slow if it has taken longer than the average
+            /// tile while there are threads with nothing queued for them
+            bool too_slow(std::chrono::nanoseconds const taken) const {
+                std::uint64_t const timed = tiles_timed;
+                return timed
+                        and std::uint64_t(taken.count()) * timed > tile_time
+                        and workers.queued_jobs() < workers.size();
+            }
+        };
+    }
+
+
+    /// Queue the rendering of a frame on the pool as one job per tile. Each
+    /// job writes its tile directly into the film, and the returned future
+    /// holds the film once every tile is done, or the first exception
+    /// thrown by `fn`, in which case the remaining tiles are skipped.
+    /// `progress` must outlive the future becoming ready. Tiles from
+    /// several frames can be queued at once, so the next frame can start as
+    /// the workers run out of tiles from the current one
     template<typename film_type, typename Fn>
-    film_type sub_panel(
+    std::future<film_type> sub_panel(
+            pool &workers,
             sub_panel_progress &progress,
-            std::size_t const threads,
             typename film_type::size_type const width,
             typename film_type::size_type const height,
             Fn fn) {
-        using panel_type = animray::panel<film_type>;
-        using calculation_type = animray::film<std::future<panel_type>>;
-
-        std::vector<std::pair<std::size_t, std::size_t>> futures;
-        calculation_type work{
-                progress.panel_count_x, progress.panel_count_y,
-                [&fn, &progress, &futures](auto const pr, auto const pc) {
-                    futures.emplace_back(pr, pc);
-                    return std::async(
-                            std::launch::deferred, [pr, pc, &fn, &progress]() {
-                                auto r = panel_type{
-                                        progress.panel_size_x,
-                                        progress.panel_size_y,
-                                        progress.panel_size_x * pr,
-                                        progress.panel_size_y * pc, fn};
-                                ++progress.count;
-                                return r;
-                            });
-                }};
-        std::atomic<std::size_t> next{};
-        std::vector<std::thread> joins;
-        joins.reserve(threads);
-        for (std::size_t thread{}; thread != threads; ++thread) {
-            joins.emplace_back([&futures, &next, &work]() {
-                for (std::size_t index = next++; index < futures.size();
-                     index = next++) {
-                    auto const [r, c] = futures[index];
-                    work[r][c].wait();
-                }
+        using frame = detail::sub_panel_frame<film_type, Fn>;
+        auto state = std::make_shared<frame>(
+                workers, progress, width, height, std::move(fn));
+        auto result = state->result.get_future();
+        for (auto const tile : progress.order) {
+            auto const area = progress.template panel<
+                    typename film_type::extents_type>(tile);
+            workers.post([state, tile, area]() {
+                frame::render(
+                        state, tile, area.lower_left.y, area.top_right.y + 1);
             });
         }
-        for (auto &th : joins) { th.join(); }
-        auto panels = animray::film<panel_type>{
-                progress.panel_count_x, progress.panel_count_y,
-                [&work](auto const r, auto const c) {
-                    return work[r][c].get();
-                }};
-        return film_type{
-                width, height,
-                [&panels, &progress](auto const x, auto const y) {
-                    return panels[x / progress.panel_size_x]
-                                 [y / progress.panel_size_y]
-                                 [x % progress.panel_size_x]
-                                 [y % progress.panel_size_y];
-                }};
+        return result;
     }
 
 
+    /// Render a frame in sub-panels on a pool of `threads` threads that is
+    /// only used for this frame. Use the overload that takes a `pool` to
+    /// keep the threads between frames
+    template<typename film_type, typename Fn>
+    film_type sub_panel(
+            sub_panel_progress &progress,
+            std::size_t const threads,
+            typename film_type::size_type const width,
+            typename film_type::size_type const height,
+            Fn fn) {
+        pool workers{threads};
+        return workers.wait(sub_panel<film_type>(
+                workers, progress, width, height, std::move(fn)));
+    }
+
 }
 
 
@@ -0,0 +1,46 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_UNBOUNDED_HPP
+#define ANIMRAY_UNBOUNDED_HPP
+#pragma once
+
+
+#include <limits>
+
+
+namespace animray {
+
+    /**
+     * `unbounded` is the distance used for queries that carry on along a
+     * ray for ever. It is infinity for types that have one and the largest
+     * value for those that don't.
+     */
+
+    template<typename T>
+    constexpr inline T unbounded = std::numeric_limits<T>::has_infinity
+            ? std::numeric_limits<T>::infinity()
+            : std::numeric_limits<T>::max();
+
+
+}
+
+
+#endif // ANIMRAY_UNBOUNDED_HPP
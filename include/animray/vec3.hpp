@@ -0,0 +1,163 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ANIMRAY_VEC3_HPP
+#define ANIMRAY_VEC3_HPP
+#pragma once
+
+
+#include <animray/unit-vector.hpp>
+
+
+namespace animray {
+
+
+    template<typename D>
+    class unit_vec3;
+
+
+    /**
+     * # Non-homogeneous vector
+     *
+     * Stores only the three Cartesian components, so none of the operations
+     * have to divide through by `w` the way `point3d` and `unit_vector` do.
+     * `unit_vec3` is the matching direction type, and the pair can be used as
+     * the `end_type` and `direction_type` of a `ray`:
+     * ```cpp
+     * using fast_ray = animray::ray<float, vec3<float>, unit_vec3<float>>;
+     * ```
+     */
+    template<typename D>
+    class alignas(16) vec3 : protected detail::array_based<D, 3> {
+        using superclass = detail::array_based<D, 3>;
+
+      public:
+        using value_type = typename superclass::value_type;
+        using array_type = typename superclass::array_type;
+        static constexpr std::size_t c_array_size = superclass::c_array_size;
+        using superclass::print_on;
+
+        /// Construct the zero vector
+        constexpr vec3() = default;
+        /// Construct from the three components
+        constexpr vec3(
+                value_type const x, value_type const y, value_type const z) {
+            superclass::array[0] = x;
+            superclass::array[1] = y;
+            superclass::array[2] = z;
+        }
+        /// Convert from a homogeneous location
+        explicit vec3(point3d<value_type> const &p)
+        : vec3{p.x(), p.y(), p.z()} {}
+        /// Convert from a unit vector
+        explicit vec3(unit_vector<value_type> const &v)
+        : vec3{v.x(), v.y(), v.z()} {}
+
+        /// Convert to a homogeneous location
+        explicit operator point3d<value_type>() const {
+            return {x(), y(), z()};
+        }
+
+        /// Return the 3 underlying coordinates
+        array_type const &array() const { return superclass::array; }
+
+        /// The x coordinate
+        value_type x() const { return superclass::array[0]; }
+        /// The y coordinate
+        value_type y() const { return superclass::array[1]; }
+        /// The z coordinate
+        value_type z() const { return superclass::array[2]; }
+
+        /// Compare for equality
+        bool operator==(vec3 const &r) const {
+            return superclass::array == r.superclass::array;
+        }
+
+        /// Binary subtraction
+        vec3 operator-(vec3 const &r) const {
+            return {x() - r.x(), y() - r.y(), z() - r.z()};
+        }
+        /// Binary addition
+        vec3 operator+(vec3 const &r) const {
+            return {x() + r.x(), y() + r.y(), z() + r.z()};
+        }
+        /// Multiply by a scalar
+        vec3 operator*(value_type const s) const {
+            return {x() * s, y() * s, z() * s};
+        }
+        /// Unary minus
+        vec3 operator-() const { return {-x(), -y(), -z()}; }
+
+        /// The dot product of the vector with itself
+        value_type dot() const { return x() * x() + y() * y() + z() * z(); }
+        /// The length of the vector
+        value_type magnitude() const { return std::sqrt(dot()); }
+        /// The vector scaled to unit length
+        unit_vec3<D> unit() const;
+    };
+
+
+    template<typename V>
+    vec3(V, V, V) -> vec3<V>;
+
+
+    /// A `vec3` that is known to be unit length
+    template<typename D>
+    class unit_vec3 : public vec3<D> {
+        using superclass = vec3<D>;
+
+      public:
+        using value_type = D;
+
+        /// Constructs a unit vector pointing along the z axis
+        constexpr unit_vec3() : superclass{0, 0, 1} {}
+        /// Constructs a unit vector (already normalised)
+        constexpr unit_vec3(
+                value_type const x, value_type const y, value_type const z)
+        : superclass{x, y, z} {}
+        /// Normalise a vector
+        explicit unit_vec3(vec3<D> const &v) : unit_vec3{v.unit()} {}
+        /// Convert from a homogeneous unit vector
+        explicit unit_vec3(unit_vector<D> const &v)
+        : superclass{v.x(), v.y(), v.z()} {}
+
+        /// Convert to a homogeneous unit vector
+        explicit operator unit_vector<D>() const {
+            return {superclass::x(), superclass::y(), superclass::z()};
+        }
+
+        /// Unary minus
+        unit_vec3 operator-() const {
+            return {-superclass::x(), -superclass::y(), -superclass::z()};
+        }
+    };
+
+
+}
+
+
+template<typename D>
+animray::unit_vec3<D> animray::vec3<D>::unit() const {
+    value_type const scale = value_type{1} / magnitude();
+    return {x() * scale, y() * scale, z() * scale};
+}
+
+
+#endif // ANIMRAY_VEC3_HPP
@@ -70,6 +70,7 @@ int main(int argc, char const *const argv[]) {
             cube, animray::library::lights::narrow_block<world>,
             animray::rgb<float>{5, 18, 25}};
 
+    animray::cli::frame_renderer renderer{threads};
     for (std::size_t frame{}; frame != frames; ++frame) {
         animray::movable<
                 animray::stacatto_movie<animray::pinhole_camera<
@@ -84,9 +85,9 @@ int main(int argc, char const *const argv[]) {
 
         using film_type = animray::film<animray::rgb<uint8_t>>;
 
-        animray::cli_render_frame<film_type>(
-                args, frame, threads,
-                [samples, &scene, &camera](
+        renderer.render<film_type>(
+                args, frame,
+                [samples, &scene, camera = std::move(camera)](
                         const film_type::size_type x,
                         const film_type::size_type y) {
                     animray::rgb<float> photons;
@@ -98,5 +99,7 @@ int main(int argc, char const *const argv[]) {
                 });
     }
 
+    renderer.finish();
+
     return 0;
 }
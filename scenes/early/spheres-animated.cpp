@@ -27,7 +27,7 @@
 #include <animray/color/hsl.hpp>
 #include <animray/geometry/planar/plane.hpp>
 #include <animray/geometry/quadrics/sphere-unit.hpp>
-#include <animray/geometry/collection.hpp>
+#include <animray/geometry/bvh-collection.hpp>
 #include <animray/compound.hpp>
 #include <animray/maths/angles.hpp>
 #include <animray/movable.hpp>
@@ -72,8 +72,8 @@ int main(int argc, char const *const argv[]) {
     using scene_type = animray::scene<
             animray::compound<
                     reflective_plane_type,
-                    animray::collection<metallic_sphere_type>,
-                    animray::collection<gloss_sphere_type>>,
+                    animray::bvh_collection<metallic_sphere_type>,
+                    animray::bvh_collection<gloss_sphere_type>>,
             animray::light<
                     std::tuple<
                             animray::light<void, float>,
@@ -136,6 +136,7 @@ int main(int argc, char const *const argv[]) {
                             animray::point3d<world>(5.0, -5.0, -5.0),
                             animray::rgb<float>(0x40, 0x40, 0xa0)));
 
+    animray::cli::frame_renderer renderer{threads};
     for (std::size_t frame{start_frame}; frame != frames; ++frame) {
         animray::movable<
                 animray::stacatto_movie<animray::pinhole_camera<
@@ -147,11 +148,31 @@ int main(int argc, char const *const argv[]) {
         camera(animray::translate<world>(0.0, -4.0, -40));
         camera.instance.frame = frame;
 
+        /// The hierarchies are built for the first frame and then refitted
+        /// as the spheres move
+        typename animray::with_frame<animray::ray<world>, std::size_t>::type
+                at_frame;
+        at_frame.frame = frame;
+        if (frame == start_frame) {
+            std::cout << "Metallic spheres: "
+                      << std::get<1>(scene.geometry.instances)
+                                 .build(threads, at_frame)
+                      << "\nGloss spheres: "
+                      << std::get<2>(scene.geometry.instances)
+                                 .build(threads, at_frame)
+                      << '\n';
+        } else {
+            /// The last frame may still be rendering from the spheres
+            renderer.wait();
+            std::get<1>(scene.geometry.instances).refit(at_frame);
+            std::get<2>(scene.geometry.instances).refit(at_frame);
+        }
+
         using film_type = animray::film<animray::rgb<uint8_t>>;
 
-        animray::cli_render_frame<film_type>(
-                args, frame, threads,
-                [samples, &scene, &camera](
+        renderer.render<film_type>(
+                args, frame,
+                [samples, &scene, camera = std::move(camera)](
                         const film_type::size_type x,
                         const film_type::size_type y) {
                     animray::rgb<float> photons;
@@ -172,5 +193,7 @@ int main(int argc, char const *const argv[]) {
                 });
     }
 
+    renderer.finish();
+
     return 0;
 }
@@ -22,6 +22,8 @@
 #include <animray/color/hsl.hpp>
 #include <animray/formats/targa.hpp>
 #include <animray/mandelbrot.hpp>
+#include <animray/mandelbrot/perturbation.hpp>
+#include <animray/threading/sub-panel.hpp>
 #include <iostream>
 
 
@@ -43,26 +45,58 @@ int main(int argc, char const *const argv[]) {
               << " with diameter of " << diameter << " to " << bits << " bits"
               << std::endl;
 
+    auto const colour = [hue](unsigned int d, std::size_t b) {
+        if (d) {
+            unsigned int m = (1u << b) - 1u;
+            animray::hsl<double> h(int(hue + 360.0 * d / m) % 360, 1.0, 0.5);
+            animray::rgb<double> c(
+                    animray::convert_to<animray::rgb<double>>(h));
+            return animray::rgb<uint8_t>(
+                    c.red() * 255, c.green() * 255, c.blue() * 255);
+        } else {
+            return animray::rgb<uint8_t>();
+        }
+    };
+
     using film_type = animray::film<animray::rgb<uint8_t>>;
-    film_type output(
-            args.width, args.height,
-            animray::mandelbrot::transformer<film_type, precision>(
-                    args.width, args.height, centre_x, centre_y, diameter, bits,
-                    [hue](unsigned int d, std::size_t b) {
-                        if (d) {
-                            unsigned int m = (1u << b) - 1u;
-                            animray::hsl<double> h(
-                                    int(hue + 360.0 * d / m) % 360, 1.0, 0.5);
-                            animray::rgb<double> c(
-                                    animray::convert_to<animray::rgb<double>>(
-                                            h));
-                            return animray::rgb<uint8_t>(
-                                    c.red() * 255, c.green() * 255,
-                                    c.blue() * 255);
-                        } else {
-                            return animray::rgb<uint8_t>();
-                        }
-                    }));
+    film_type output(args.width, args.height);
+    precision const per_pixel = diameter / std::min(args.width, args.height);
+    if (args.switches.contains('p')
+        or not animray::mandelbrot::enough_precision<precision>(
+                per_pixel,
+                std::max(std::abs(centre_x), std::abs(centre_y)))) {
+        /// The centre is read again from the command line so that it keeps
+        /// all of the digits it was given
+        std::size_t const limbs = animray::fixed_point::limbs_for(
+                animray::mandelbrot::reference_bits(double(per_pixel)));
+        auto const centre = [&](char const option) {
+            auto const found = args.switches.find(option);
+            return found == args.switches.end() or not found->second
+                    ? animray::fixed_point{limbs}
+                    : animray::fixed_point{found->second, limbs};
+        };
+        std::cout << "Using perturbation" << std::endl;
+        animray::mandelbrot::perturbation<film_type> const mandelbrot{
+                args.width, args.height, centre('x'), centre('y'),
+                double(diameter), bits, colour};
+        mandelbrot.fill(output);
+    } else {
+        animray::mandelbrot::transformer<film_type, precision> const
+                mandelbrot{args.width, args.height, centre_x, centre_y,
+                           diameter,   bits,        colour};
+        if (args.switches.contains('s')) {
+            std::cout << "Subdividing tiles" << std::endl;
+            animray::threading::sub_panel_progress progress{
+                    args.width, args.height};
+            output = animray::threading::sub_panel<film_type>(
+                    progress, std::thread::hardware_concurrency(), args.width,
+                    args.height, [&](film_type::region_view const &region) {
+                        mandelbrot.subdivide(region);
+                    });
+        } else {
+            mandelbrot.fill(output);
+        }
+    }
 
     animray::targa(args.output_filename, output);
 
@@ -19,8 +19,14 @@
 
 
 #include <animray/animation/animate.hpp>
+#include <animray/mixins/frame.hpp>
+#include <animray/point3d.hpp>
+#include <animray/ray.hpp>
 #include <felspar/test.hpp>
 
+#include <thread>
+#include <vector>
+
 
 namespace {
 
@@ -44,4 +50,79 @@ namespace {
             "scalar", [](auto) { animray::animatable<int> value{2}; });
 
 
+    /// Counts how often the animation is evaluated
+    struct counted {
+        std::size_t *calls;
+        animray::point3d<double> operator()(std::size_t const frame) const {
+            ++*calls;
+            return {double(frame), 0, 0};
+        }
+    };
+    using frame_ray =
+            animray::with_frame<animray::ray<double>, std::size_t>::type;
+
+
+    auto const f = suite.test("once per frame", [](auto check) {
+        std::size_t calls{};
+        animray::animate<counted> const position{counted{&calls}};
+        frame_ray ray;
+        for (std::size_t frame{}; frame < 3; ++frame) {
+            ray.frame = frame;
+            for (std::size_t count{}; count < 10; ++count) {
+                check(position(ray).x()) == double(frame);
+            }
+        }
+        check(calls) == 3u;
+
+        auto const copy = position;
+        check(copy(ray).x()) == 2.0;
+        check(calls) == 4u;
+    });
+
+
+    auto const o = suite.test("overlapping frames", [](auto check) {
+        animray::frame_cache<double> cache;
+        std::size_t calls{};
+        auto const calculate = [&calls](double const f) {
+            ++calls;
+            return f * 2;
+        };
+        for (std::size_t count{}; count < 10; ++count) {
+            check(cache(4, calculate)) == 8.0;
+            check(cache(5, calculate)) == 10.0;
+        }
+        check(calls) == 2u;
+        /// Jittered frame times are never stored, so don't push out the
+        /// whole frames
+        check(cache(4.25, calculate)) == 8.5;
+        check(cache(4.25, calculate)) == 8.5;
+        check(calls) == 4u;
+        check(cache(4, calculate)) == 8.0;
+        check(cache(5, calculate)) == 10.0;
+        check(calls) == 4u;
+    });
+
+
+    auto const t = suite.test("threaded", [](auto check) {
+        animray::frame_cache<std::array<double, 5>> cache;
+        std::vector<std::thread> threads;
+        std::vector<std::size_t> wrong(4);
+        for (std::size_t thread{}; thread < wrong.size(); ++thread) {
+            threads.emplace_back([&cache, &wrong, thread]() {
+                for (std::size_t count{}; count < 20000; ++count) {
+                    double const frame = (count + thread) % 7;
+                    auto const v = cache(frame, [](double const f) {
+                        return std::array<double, 5>{f, f, f, f, f};
+                    });
+                    for (auto const d : v) {
+                        if (d != frame) { ++wrong[thread]; }
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) { thread.join(); }
+        for (auto const w : wrong) { check(w) == 0u; }
+    });
+
+
 }
@@ -22,6 +22,8 @@
 #include <animray/functional/traits.hpp>
 #include <felspar/test.hpp>
 
+#include <future>
+
 
 namespace {
 
@@ -76,4 +78,60 @@ namespace {
     });
 
 
+
+    auto const frow = suite.test("row major layout", [](auto check) {
+        animray::film<std::size_t> const image{
+                5, 3, [](std::size_t x, std::size_t y) { return y * 10 + x; }};
+        check(reinterpret_cast<std::uintptr_t>(image.storage().data()) % 64)
+                == 0u;
+        check(image.storage().size()) == 15u;
+        auto const row = image.row(1);
+        check(row.size()) == 5u;
+        check(row[0]) == 10u;
+        check(row[4]) == 14u;
+        check(image[3][2]) == 23u;
+
+        std::vector<std::size_t> order;
+        image.for_each_row([&](auto const p) { order.push_back(p); });
+        check(order.size()) == 15u;
+        check(order[5]) == 10u;
+    });
+
+
+    auto const ftile = suite.test("tiled layout", [](auto check) {
+        using tiled = animray::layout::tiled<4>;
+        check(tiled::morton(0, 0)) == 0u;
+        check(tiled::morton(1, 0)) == 1u;
+        check(tiled::morton(0, 1)) == 2u;
+        check(tiled::morton(3, 3)) == 15u;
+
+        animray::film<std::size_t, std::size_t, tiled> image{
+                6, 5, [](std::size_t x, std::size_t y) { return y * 10 + x; }};
+        check(image.storage().size()) == 4u * 16u;
+        check(image[5][4]) == 45u;
+        auto const tile = image.tile(1, 0);
+        check(tile[0]) == 4u;
+        check(tile[1]) == 5u;
+        check(tile[2]) == 14u;
+
+        std::vector<std::size_t> rows, stored;
+        image.for_each_row([&](auto const p) { rows.push_back(p); });
+        image.for_each([&](auto const p) { stored.push_back(p); });
+        check(rows.size()) == 30u;
+        check(stored.size()) == 30u;
+        check(rows[6]) == 10u;
+        check(stored[2]) == 10u;
+    });
+
+
+    auto const fmove = suite.test("move only pixels", [](auto check) {
+        animray::film<std::future<int>> work{
+                3, 2, [](std::size_t x, std::size_t y) {
+                    return std::async(std::launch::deferred, [x, y]() {
+                        return int(x * y);
+                    });
+                }};
+        check(work[2][1].get()) == 2;
+    });
+
 }
@@ -0,0 +1,112 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/formats/exr.hpp>
+#include <felspar/test.hpp>
+
+#include <limits>
+#include <string_view>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    auto const half = suite.test("half", [](auto check) {
+        check(animray::half(0.0f)) == 0x0000;
+        check(animray::half(-0.0f)) == 0x8000;
+        check(animray::half(1.0f)) == 0x3c00;
+        check(animray::half(-2.0f)) == 0xc000;
+        check(animray::half(0.1f)) == 0x2e66;
+        check(animray::half(65504.0f)) == 0x7bff;
+        check(animray::half(65519.0f)) == 0x7bff;
+        check(animray::half(65520.0f)) == 0x7c00;
+        check(animray::half(1e10f)) == 0x7c00;
+        check(animray::half(-std::numeric_limits<float>::infinity()))
+                == 0xfc00;
+        check(animray::half(std::numeric_limits<float>::quiet_NaN()) & 0x7e00)
+                == 0x7e00;
+        /// Ties go to the even value
+        check(animray::half(1.0f + 1.0f / 2048)) == 0x3c00;
+        check(animray::half(1.0f + 3.0f / 2048)) == 0x3c02;
+        /// The smallest normal and the subnormals below it
+        check(animray::half(6.103515625e-05f)) == 0x0400;
+        check(animray::half(5.9604645e-08f)) == 0x0001;
+        check(animray::half(5.9604645e-08f / 2)) == 0x0000;
+        check(animray::half(5.9604645e-08f * 1.5f)) == 0x0002;
+        check(animray::half(6.0975552e-05f)) == 0x03ff;
+        check(animray::half(1e-10f)) == 0x0000;
+    });
+
+
+    auto const file = suite.test("file", [](auto check) {
+        animray::film<animray::rgb<float>> const image{
+                5, 3, [](std::size_t x, std::size_t y) {
+                    return animray::rgb<float>(x, y, 1000);
+                }};
+        auto const bytes = animray::exr_bytes(image);
+        auto const u32 = [&](std::size_t const at) {
+            std::uint32_t v{};
+            for (std::size_t b{}; b != 4; ++b) {
+                v |= std::uint32_t(std::uint8_t(bytes[at + b])) << (8 * b);
+            }
+            return v;
+        };
+        check(u32(0)) == 20000630u;
+        check(u32(4)) == 2u;
+
+        /// Find the end of the header by walking the attributes
+        std::size_t at = 8;
+        std::vector<std::string_view> names;
+        while (bytes[at]) {
+            names.emplace_back(bytes.data() + at);
+            at += names.back().size() + 1;
+            at += std::string_view{bytes.data() + at}.size() + 1;
+            at += 4 + u32(at);
+        }
+        ++at;
+        check(names.size()) == 8u;
+        check(names.front()) == "channels";
+
+        std::size_t const line = 8 + 5 * 3 * 2;
+        check(bytes.size()) == at + 3 * 8 + 3 * line;
+        for (std::uint32_t y{}; y != 3; ++y) {
+            std::size_t const offset = u32(at + y * 8);
+            check(offset) == at + 3 * 8 + y * line;
+            check(u32(offset)) == y;
+            check(u32(offset + 4)) == 5u * 3 * 2;
+            auto const channel = [&](std::size_t c, std::size_t x) {
+                auto const p = offset + 8 + (c * 5 + x) * 2;
+                return std::uint16_t(
+                        std::uint8_t(bytes[p])
+                        | (std::uint8_t(bytes[p + 1]) << 8));
+            };
+            for (std::size_t x{}; x != 5; ++x) {
+                check(channel(0, x)) == animray::half(1000.0f);
+                check(channel(1, x)) == animray::half(float(y));
+                check(channel(2, x)) == animray::half(float(x));
+            }
+        }
+    });
+
+
+}
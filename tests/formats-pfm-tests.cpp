@@ -0,0 +1,79 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/formats/pfm.hpp>
+#include <felspar/test.hpp>
+
+#include <cstring>
+#include <string_view>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    float read_float(std::vector<char> const &file, std::size_t const at) {
+        std::uint32_t bits{};
+        for (std::size_t byte{}; byte != 4; ++byte) {
+            bits |= std::uint32_t(std::uint8_t(file[at + byte])) << (8 * byte);
+        }
+        float f;
+        std::memcpy(&f, &bits, 4);
+        return f;
+    }
+
+
+    auto const colour = suite.test("colour", [](auto check) {
+        animray::film<animray::rgb<float>> const image{
+                3, 2, [](std::size_t x, std::size_t y) {
+                    return animray::rgb<float>(x, y * 100.5f, -0.25f);
+                }};
+        auto const file = animray::pfm_bytes(image);
+        std::string_view const header{"PF\n3 2\n-1.0\n"};
+        check(std::string_view{file.data(), header.size()}) == header;
+        check(file.size()) == header.size() + 3 * 2 * 3 * 4;
+        /// The bottom row comes first
+        check(read_float(file, header.size())) == 0.0f;
+        check(read_float(file, header.size() + 4)) == 100.5f;
+        check(read_float(file, header.size() + 8)) == -0.25f;
+        check(read_float(file, header.size() + 12)) == 1.0f;
+        check(read_float(file, header.size() + 36)) == 0.0f;
+        check(read_float(file, header.size() + 40)) == 0.0f;
+    });
+
+
+    auto const grey = suite.test("grey", [](auto check) {
+        animray::film<float> const image{
+                2, 2, [](std::size_t x, std::size_t y) {
+                    return 1e6f * x + y;
+                }};
+        auto const file = animray::pfm_bytes(image);
+        std::string_view const header{"Pf\n2 2\n-1.0\n"};
+        check(std::string_view{file.data(), header.size()}) == header;
+        check(file.size()) == header.size() + 2 * 2 * 4;
+        check(read_float(file, header.size())) == 1.0f;
+        check(read_float(file, header.size() + 4)) == 1e6f + 1;
+        check(read_float(file, header.size() + 8)) == 0.0f;
+    });
+
+
+}
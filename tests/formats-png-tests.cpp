@@ -0,0 +1,184 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/formats/png.hpp>
+#include <felspar/test.hpp>
+
+#include <random>
+#include <string_view>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    std::span<std::uint8_t const> bytes(std::string_view const s) {
+        return {reinterpret_cast<std::uint8_t const *>(s.data()), s.size()};
+    }
+
+
+    auto const checksums = suite.test("checksums", [](auto check) {
+        check(animray::deflate::crc32(bytes("123456789"))) == 0xcbf43926u;
+        check(animray::deflate::adler32(bytes("Wikipedia"))) == 0x11e60398u;
+        check(animray::deflate::adler32_combine(
+                animray::deflate::adler32(bytes("Wiki")),
+                animray::deflate::adler32(bytes("pedia")), 5))
+                == 0x11e60398u;
+    });
+
+
+    /// Expand deflate data made of fixed Huffman and stored blocks, which
+    /// is everything that `deflate::compress` makes
+    std::vector<std::uint8_t> inflate(std::span<std::uint8_t const> in) {
+        std::size_t bit{};
+        auto const bits = [&](unsigned const n) {
+            unsigned v{};
+            for (unsigned i{}; i != n; ++i, ++bit) {
+                v |= ((in[bit / 8] >> (bit % 8)) & 1) << i;
+            }
+            return v;
+        };
+        auto const huffman = [&](unsigned const n) {
+            unsigned v{};
+            for (unsigned i{}; i != n; ++i) { v = (v << 1) | bits(1); }
+            return v;
+        };
+        auto const symbol = [&]() {
+            unsigned code = huffman(7);
+            if (code <= 0x17) { return code + 256; }
+            code = (code << 1) | bits(1);
+            if (code >= 0x30 and code <= 0xbf) { return code - 0x30; }
+            if (code >= 0xc0 and code <= 0xc7) { return code - 0xc0 + 280; }
+            return ((code << 1) | bits(1)) - 0x190 + 144;
+        };
+        constexpr unsigned length_base[] = {
+                3,  4,  5,  6,  7,  8,  9,   10,  11,  13,
+                15, 17, 19, 23, 27, 31, 35,  43,  51,  59,
+                67, 83, 99, 115, 131, 163, 195, 227, 258};
+        constexpr unsigned length_extra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+                                             1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                             4, 4, 4, 4, 5, 5, 5, 5, 0};
+        std::vector<std::uint8_t> out;
+        bool last = false;
+        while (not last) {
+            last = bits(1);
+            if (bits(2) == 0) {
+                bit = (bit + 7) / 8 * 8;
+                unsigned const length = bits(16);
+                bits(16);
+                for (unsigned i{}; i != length; ++i) { out.push_back(bits(8)); }
+                continue;
+            }
+            for (unsigned s = symbol(); s != 256; s = symbol()) {
+                if (s < 256) {
+                    out.push_back(s);
+                } else {
+                    unsigned const length = length_base[s - 257]
+                            + bits(length_extra[s - 257]);
+                    unsigned const d = huffman(5);
+                    unsigned const extra = d < 4 ? 0 : d / 2 - 1;
+                    unsigned const base = d < 4
+                            ? d + 1
+                            : ((2 + d % 2) << extra) + 1;
+                    std::size_t const distance = base + bits(extra);
+                    for (unsigned i{}; i != length; ++i) {
+                        out.push_back(out[out.size() - distance]);
+                    }
+                }
+            }
+        }
+        return out;
+    }
+
+
+    auto const deflate = suite.test("deflate", [](auto check) {
+        std::mt19937 generator;
+        std::vector<std::uint8_t> data;
+        for (std::size_t i{}; i != 100000; ++i) {
+            data.push_back(
+                    i % 1000 < 600 ? std::uint8_t(i % 17)
+                                   : std::uint8_t(generator()));
+        }
+        std::vector<std::uint8_t> compressed;
+        animray::deflate::compress(
+                std::span{data}.first(40000), false, compressed);
+        animray::deflate::compress(
+                std::span{data}.subspan(40000), true, compressed);
+        check(compressed.size()) < data.size() / 2;
+        check(inflate(compressed) == data) == true;
+    });
+
+
+    auto const png = suite.test("png", [](auto check) {
+        animray::film<animray::rgb<uint8_t>> const image{
+                75, 70, [](std::size_t x, std::size_t y) {
+                    return animray::rgb<uint8_t>(x, y, x * y);
+                }};
+        auto const file = animray::png_bytes(image);
+        animray::threading::pool workers{3};
+        check(animray::png_bytes(image, &workers) == file) == true;
+
+        check(std::string_view{reinterpret_cast<char const *>(file.data()), 8})
+                == "\x89PNG\r\n\x1a\n";
+        /// The image header is 13 bytes long, and starts with the width
+        check(int(file[11])) == 13;
+        check(int(file[19])) == 75;
+        check(int(file[23])) == 70;
+        check(int(file[25])) == 2;
+        std::size_t const idat = 8 + 12 + 13;
+        std::size_t const length = (file[idat] << 24) | (file[idat + 1] << 16)
+                | (file[idat + 2] << 8) | file[idat + 3];
+        auto const zlib = std::span{file}.subspan(idat + 8, length);
+        auto const filtered = inflate(zlib.subspan(2, zlib.size() - 6));
+        check(filtered.size()) == 70u * (75 * 3 + 1);
+        check(animray::deflate::adler32(filtered))
+                == std::uint32_t((zlib[length - 4] << 24)
+                                 | (zlib[length - 3] << 16)
+                                 | (zlib[length - 2] << 8) | zlib[length - 1]);
+
+        /// Undo the filters and compare the pixels
+        std::size_t const stride = 75 * 3;
+        std::vector<std::uint8_t> above(stride), row(stride);
+        std::size_t wrong{};
+        for (std::size_t y{}; y != 70; ++y) {
+            auto const *const in = filtered.data() + y * (stride + 1);
+            for (std::size_t i{}; i != stride; ++i) {
+                int const a = i >= 3 ? row[i - 3] : 0, b = above[i],
+                          c = i >= 3 ? above[i - 3] : 0;
+                int const predicted[] = {
+                        0, a, b, (a + b) / 2,
+                        animray::detail::paeth(a, b, c)};
+                row[i] = in[1 + i] + predicted[in[0]];
+            }
+            for (std::size_t x{}; x != 75; ++x) {
+                if (row[x * 3] != x or row[x * 3 + 1] != y
+                    or row[x * 3 + 2] != std::uint8_t(x * y)) {
+                    ++wrong;
+                }
+            }
+            std::swap(above, row);
+        }
+        check(wrong) == 0u;
+    });
+
+
+}
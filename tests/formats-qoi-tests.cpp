@@ -0,0 +1,116 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/formats/qoi.hpp>
+#include <felspar/test.hpp>
+
+#include <string_view>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    /// Decode the pixels following the specification, returning them and the
+    /// number of bytes read including the end marker
+    auto decode(std::vector<std::uint8_t> const &file) {
+        std::size_t const count = (std::size_t(file[6]) << 8 | file[7])
+                * (std::size_t(file[10]) << 8 | file[11]);
+        std::vector<std::array<std::uint8_t, 4>> pixels;
+        std::array<std::array<std::uint8_t, 4>, 64> seen{};
+        std::array<std::uint8_t, 4> p{0, 0, 0, 255};
+        std::size_t index = 14;
+        while (pixels.size() < count) {
+            std::uint8_t const op = file[index++];
+            std::size_t repeat = 1;
+            if (op == 0xfe) {
+                p = {file[index], file[index + 1], file[index + 2], p[3]};
+                index += 3;
+            } else if (op == 0xff) {
+                p = {file[index], file[index + 1], file[index + 2],
+                     file[index + 3]};
+                index += 4;
+            } else if (op >> 6 == 0) {
+                p = seen[op];
+            } else if (op >> 6 == 1) {
+                p = {std::uint8_t(p[0] + ((op >> 4) & 3) - 2),
+                     std::uint8_t(p[1] + ((op >> 2) & 3) - 2),
+                     std::uint8_t(p[2] + (op & 3) - 2), p[3]};
+            } else if (op >> 6 == 2) {
+                int const dg = (op & 0x3f) - 32, n = file[index++];
+                p = {std::uint8_t(p[0] + dg + (n >> 4) - 8),
+                     std::uint8_t(p[1] + dg),
+                     std::uint8_t(p[2] + dg + (n & 15) - 8), p[3]};
+            } else {
+                repeat = (op & 0x3f) + 1;
+            }
+            seen[(p[0] * 3 + p[1] * 5 + p[2] * 7 + p[3] * 11) % 64] = p;
+            pixels.insert(pixels.end(), repeat, p);
+        }
+        return std::pair{pixels, index + 8};
+    }
+
+
+    auto const qoi = suite.test("qoi", [](auto check) {
+        animray::film<animray::rgb<uint8_t>> const image{
+                40, 30, [](std::size_t x, std::size_t y) {
+                    return y < 10 ? animray::rgb<uint8_t>(10, 20, 30)
+                                  : animray::rgb<uint8_t>(x, y * 9, x + y);
+                }};
+        auto const file = animray::qoi_bytes(image);
+        check(std::string_view{reinterpret_cast<char const *>(file.data()), 4})
+                == "qoif";
+        check(int(file[7])) == 40;
+        check(int(file[11])) == 30;
+
+        auto const [pixels, size] = decode(file);
+        check(size) == file.size();
+        std::size_t wrong{};
+        for (std::size_t y{}; y != 30; ++y) {
+            for (std::size_t x{}; x != 40; ++x) {
+                auto const &c = image[x][y];
+                if (pixels[y * 40 + x]
+                    != std::array<std::uint8_t, 4>{
+                            c.red(), c.green(), c.blue(), 255}) {
+                    ++wrong;
+                }
+            }
+        }
+        check(wrong) == 0u;
+    });
+
+
+    auto const black = suite.test("black after colour", [](auto check) {
+        animray::film<animray::rgb<uint8_t>> const image{
+                2, 1, [](std::size_t x, std::size_t) {
+                    return x == 0 ? animray::rgb<uint8_t>(200, 100, 50)
+                                  : animray::rgb<uint8_t>(0, 0, 0);
+                }};
+        auto const [pixels, size] = decode(animray::qoi_bytes(image));
+        check(pixels.size()) == 2u;
+        check(pixels[0]) == std::array<std::uint8_t, 4>{200, 100, 50, 255};
+        check(pixels[1]) == std::array<std::uint8_t, 4>{0, 0, 0, 255};
+    });
+
+
+
+}
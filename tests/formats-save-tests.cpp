@@ -0,0 +1,89 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <animray/formats/save.hpp>
+#include <felspar/test.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    /// Somewhere to save a file called `name`
+    std::filesystem::path temporary(std::string const &name) {
+        return std::filesystem::temp_directory_path() / ("animray-" + name);
+    }
+
+
+    /// Save the film and return the first four bytes of the file
+    template<typename F>
+    std::string saved(F const &image, std::string const &name) {
+        auto const path = temporary(name);
+        animray::save(path, image);
+        std::ifstream file{path, std::ios::binary};
+        std::string start(4, '\0');
+        file.read(start.data(), 4);
+        std::filesystem::remove(path);
+        return start;
+    }
+
+
+    auto const eight = suite.test("8 bit", [](auto check) {
+        animray::film<animray::rgb<uint8_t>> const image{
+                3, 2, animray::rgb<uint8_t>(10, 20, 30)};
+        check(saved(image, "image.png")) == "\x89PNG";
+        check(saved(image, "image.qoi")) == "qoif";
+        /// A raw colour Targa file has no image ID or colour map
+        check(saved(image, "image.tga")) == std::string("\0\0\2\0", 4);
+        for (auto const name : {"image.jpg", "image.exr", "image"}) {
+            check([&]() { saved(image, name); })
+                    .throws(std::invalid_argument{
+                            "Images are saved as .png, .qoi or .tga, not "
+                            + temporary(name).string()});
+            check(std::filesystem::exists(temporary(name))) == false;
+        }
+    });
+
+
+    auto const floating = suite.test("floating point", [](auto check) {
+        animray::film<animray::rgb<float>> const image{
+                3, 2, animray::rgb<float>(0.25f, 0.5f, 2.0f)};
+        check(saved(image, "image.exr")) == "\x76\x2f\x31\x01";
+        check(saved(image, "image.pfm").substr(0, 3)) == "PF\n";
+        check(saved(animray::film<float>{3, 2, 1.5f}, "grey.pfm")
+                      .substr(0, 3))
+                == "Pf\n";
+        for (auto const name : {"image.tga", "image.png", "image"}) {
+            check([&]() { saved(image, name); })
+                    .throws(std::invalid_argument{
+                            "Floating point images are saved as .exr or "
+                            ".pfm, not "
+                            + temporary(name).string()});
+            check(std::filesystem::exists(temporary(name))) == false;
+        }
+    });
+
+}
@@ -0,0 +1,132 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/formats/targa.hpp>
+#include <felspar/test.hpp>
+
+#include <filesystem>
+#include <stdexcept>
+#include <string_view>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    /// Expand the run length encoded pixels of `B` bytes each
+    template<std::size_t B>
+    std::vector<char> decode(std::vector<char> const &file) {
+        std::vector<char> pixels;
+        for (std::size_t index = 18; index < file.size() - 26;) {
+            auto const packet = static_cast<unsigned char>(file[index++]);
+            std::size_t const count = (packet & 0x7f) + 1;
+            if (packet & 0x80) {
+                for (std::size_t p{}; p != count; ++p) {
+                    pixels.insert(
+                            pixels.end(), file.begin() + index,
+                            file.begin() + index + B);
+                }
+                index += B;
+            } else {
+                pixels.insert(
+                        pixels.end(), file.begin() + index,
+                        file.begin() + index + count * B);
+                index += count * B;
+            }
+        }
+        return pixels;
+    }
+
+
+    auto const header = suite.test("header", [](auto check) {
+        animray::film<animray::rgb<uint8_t>> const image{300, 2};
+        auto const bytes = animray::targa_bytes(image);
+        check(bytes.size()) == 18u + 300 * 2 * 3 + 26;
+        check(int(bytes[2])) == 2;
+        check(int(bytes[12])) == 0x2c;
+        check(int(bytes[13])) == 0x01;
+        check(int(bytes[14])) == 2;
+        check(int(bytes[15])) == 0;
+        check(int(bytes[16])) == 24;
+        check(std::string_view{bytes.data() + bytes.size() - 18, 17})
+                == "TRUEVISION-XFILE.";
+
+        auto const rle = animray::targa_bytes(
+                image, animray::targa_encoding::rle);
+        check(int(rle[2])) == 10;
+        /// Each row is three full runs of 128, 128 and 44 pixels
+        check(rle.size()) == 18u + 2 * 3 * 4 + 26;
+    });
+
+
+    auto const rgb = suite.test("rgb rle", [](auto check) {
+        animray::film<animray::rgb<uint8_t>> const image{
+                257, 5, [](std::size_t x, std::size_t y) {
+                    return animray::rgb<uint8_t>(
+                            x < 100 ? 1 : x % 7, y, x < 200 ? 0 : x % 3);
+                }};
+        auto const raw = animray::targa_bytes(image);
+        auto const rle = animray::targa_bytes(
+                image, animray::targa_encoding::rle);
+        check(rle.size()) < raw.size();
+        auto const pixels = decode<3>(rle);
+        check(pixels.size()) == 257u * 5 * 3;
+        check(std::equal(pixels.begin(), pixels.end(), raw.begin() + 18))
+                == true;
+        check(int(raw[18])) == 0;
+        check(int(raw[19])) == 0;
+        check(int(raw[20])) == 1;
+    });
+
+
+    auto const grey = suite.test("grey rle", [](auto check) {
+        animray::film<uint8_t> const image{
+                131, 3, [](std::size_t x, std::size_t y) {
+                    return uint8_t(x % 2 ? x : y);
+                }};
+        auto const raw = animray::targa_bytes(image);
+        auto const rle = animray::targa_bytes(
+                image, animray::targa_encoding::rle);
+        check(int(rle[2])) == 11;
+        auto const pixels = decode<1>(rle);
+        check(pixels.size()) == 131u * 3;
+        check(std::equal(pixels.begin(), pixels.end(), raw.begin() + 18))
+                == true;
+    });
+
+
+    auto const errors = suite.test("errors", [](auto check) {
+        animray::film<uint8_t> const image{4, 4, uint8_t{}};
+        check([&]() {
+            animray::targa("missing-directory/image.tga", image);
+        }).throws(std::runtime_error{
+                "Could not open missing-directory/image.tga"});
+        /// Writes to `/dev/full` always fail as if the disk were full
+        if (std::filesystem::exists("/dev/full")) {
+            check([&]() {
+                animray::targa("/dev/full", image);
+            }).throws(std::runtime_error{"Could not write /dev/full"});
+        }
+    });
+
+
+}
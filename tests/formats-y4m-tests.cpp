@@ -0,0 +1,129 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/formats/y4m.hpp>
+#include <animray/color/yuv.hpp>
+#include <felspar/test.hpp>
+
+#include <cmath>
+#include <sstream>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    static_assert(animray::y4m_stream::accepts<
+                  animray::film<animray::rgb<uint8_t>>>);
+    static_assert(not animray::y4m_stream::accepts<
+                  animray::film<animray::rgb<float>>>);
+
+
+    auto const layout = suite.test("layout", [](auto check) {
+        std::ostringstream out;
+        animray::y4m_stream video{out, 30};
+        animray::film<animray::rgb<uint8_t>> const white{
+                5, 3, animray::rgb<uint8_t>(255, 255, 255)};
+        animray::film<animray::rgb<uint8_t>> const black{
+                5, 3, animray::rgb<uint8_t>(0, 0, 0)};
+        video.frame(white);
+        video.frame(black);
+        auto const bytes = out.str();
+
+        std::string const header = bytes.substr(0, bytes.find('\n') + 1);
+        check(header)
+                == "YUV4MPEG2 W5 H3 F30:1 Ip A1:1 C420jpeg XYSCSS=420JPEG "
+                   "XCOLORRANGE=LIMITED\n";
+        /// The chroma planes are 3x2 for a 5x3 frame
+        std::size_t const frame = 6 + 5 * 3 + 2 * 3 * 2;
+        check(bytes.size()) == header.size() + 2 * frame;
+        check(bytes.substr(header.size(), 6)) == "FRAME\n";
+        check(bytes.substr(header.size() + frame, 6)) == "FRAME\n";
+        for (std::size_t index{}; index != 5 * 3 + 2 * 3 * 2; ++index) {
+            auto const w = std::uint8_t(bytes[header.size() + 6 + index]);
+            auto const b =
+                    std::uint8_t(bytes[header.size() + frame + 6 + index]);
+            check(int(w)) == (index < 15 ? 235 : 128);
+            check(int(b)) == (index < 15 ? 16 : 128);
+        }
+
+        check([&]() {
+            video.frame(animray::film<animray::rgb<uint8_t>>{
+                    4, 3, animray::rgb<uint8_t>{}});
+        }).throws(std::invalid_argument{
+                "Every frame of a Y4M stream must be the same size"});
+    });
+
+
+    auto const colours = suite.test("colours", [](auto check) {
+        std::size_t worst{};
+        for (int r{}; r < 256; r += 15) {
+            for (int g{}; g < 256; g += 15) {
+                for (int b{}; b < 256; b += 15) {
+                    std::ostringstream out;
+                    animray::y4m_stream{out}.frame(
+                            animray::film<animray::rgb<uint8_t>>{
+                                    2, 2, animray::rgb<uint8_t>(r, g, b)});
+                    auto const bytes = out.str();
+                    auto const planes = bytes.size() - 6;
+                    auto const y = std::uint8_t(bytes[planes]);
+                    auto const cb = std::uint8_t(bytes[planes + 4]);
+                    auto const cr = std::uint8_t(bytes[planes + 5]);
+
+                    auto const expected =
+                            animray::convert_to<animray::yuv<float>>(
+                                    animray::rgb<float>(
+                                            r / 255.0f, g / 255.0f,
+                                            b / 255.0f));
+                    auto const error = [&](float const want, int const got) {
+                        return std::size_t(std::lround(std::abs(want - got)));
+                    };
+                    worst = std::max(
+                            {worst, error(16 + 219 * expected.y(), y),
+                             error(128 + 112 * expected.u() / 0.436f, cb),
+                             error(128 + 112 * expected.v() / 0.615f, cr)});
+                }
+            }
+        }
+        check(worst) <= 1u;
+    });
+
+
+    auto const round_trip = suite.test("yuv round trip", [](auto check) {
+        animray::rgb<float> const colour{0.25f, 0.5f, 0.875f};
+        auto const there = animray::convert_to<animray::yuv<float>>(colour);
+        auto const back = animray::convert_to<animray::rgb<float>>(there);
+        check(std::abs(back.red() - colour.red())) < 1e-6f;
+        check(std::abs(back.green() - colour.green())) < 1e-6f;
+        check(std::abs(back.blue() - colour.blue())) < 1e-6f;
+
+        /// Both ways use the same weights, so only rounding is left
+        animray::rgb<double> const precise{0.25, 0.5, 0.875};
+        auto const returned = animray::convert_to<animray::rgb<double>>(
+                animray::convert_to<animray::yuv<double>>(precise));
+        check(std::abs(returned.red() - precise.red())) < 1e-15;
+        check(std::abs(returned.green() - precise.green())) < 1e-15;
+        check(std::abs(returned.blue() - precise.blue())) < 1e-15;
+    });
+
+
+}
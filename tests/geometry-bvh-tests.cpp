@@ -0,0 +1,290 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/affine.hpp>
+#include <animray/animation/procedural/rotate.hpp>
+#include <animray/geometry/bvh-collection.hpp>
+#include <animray/geometry/collection.hpp>
+#include <animray/geometry/planar/plane.hpp>
+#include <animray/geometry/planar/triangle.hpp>
+#include <animray/geometry/quadrics/sphere-unit-origin.hpp>
+#include <animray/geometry/quadrics/sphere-unit.hpp>
+#include <animray/mixins/frame.hpp>
+#include <animray/movable.hpp>
+#include <animray/test.hpp>
+#include <felspar/test.hpp>
+
+#include <numbers>
+#include <random>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    using triangle = animray::triangle<animray::ray<double>>;
+
+
+    auto const b = suite.test("bounds", [](auto check) {
+        auto const t = triangle{
+                animray::point3d<double>(0, 0, 0),
+                animray::point3d<double>(5, 0, -1),
+                animray::point3d<double>(0, 3, 2)}
+                               .bounds();
+        check(t.lower[0]) == 0.0;
+        check(t.lower[2]) == -1.0;
+        check(t.upper[0]) == 5.0;
+        check(t.upper[1]) == 3.0;
+
+        auto const s = animray::unit_sphere<animray::point3d<double>>{
+                animray::point3d<double>(1, 2, 3)}
+                               .bounds();
+        check(s.lower[0]) == 0.0;
+        check(s.upper[2]) == 4.0;
+
+        auto const p = animray::plane<animray::ray<double>>{
+                animray::point3d<double>(0, 0, 4), {}}
+                               .bounds();
+        check(p.lower[2]) == 4.0;
+        check(p.upper[2]) == 4.0;
+        check(p.is_finite()).is_falsey();
+
+        animray::movable<animray::unit_sphere_at_origin<animray::ray<double>>>
+                m;
+        m(animray::translate<double>(10, 0, 0));
+        auto const mb = m.bounds();
+        animray::check_close(check, mb.lower[0], 9.0);
+        animray::check_close(check, mb.upper[0], 11.0);
+        animray::check_close(check, mb.upper[1], 1.0);
+    });
+
+
+    auto const e = suite.test("empty", [](auto check) {
+        animray::bvh_collection<triangle> empty;
+        empty.build();
+        check(empty.occludes(
+                      animray::ray<double>(
+                              animray::point3d<double>(0, 0, 1),
+                              animray::unit_vector<double>(0, 0, -1)),
+                      0.0))
+                .is_falsey();
+    });
+
+
+    template<typename C, typename W>
+    void matches_linear(C check, std::size_t const triangles, W &&threads) {
+        std::mt19937 generator;
+        std::uniform_real_distribution<double> place(-20, 20), size(-1, 1);
+        animray::collection<triangle> linear;
+        animray::bvh_collection<triangle> bvh;
+        for (std::size_t count{}; count != triangles; ++count) {
+            animray::point3d<double> const c(
+                    place(generator), place(generator), place(generator));
+            triangle const t{
+                    c,
+                    c
+                            + animray::point3d<double>(
+                                    size(generator), size(generator),
+                                    size(generator)),
+                    c
+                            + animray::point3d<double>(
+                                    size(generator), size(generator),
+                                    size(generator))};
+            linear.insert(t);
+            bvh.insert(t);
+        }
+        auto const stats = bvh.build(threads);
+        check(stats.instances) == triangles;
+        check(stats.nodes) == bvh.nodes.size();
+        check(stats.leaves * 2 - 1) == stats.nodes;
+        check(stats.depth) <= bvh.max_depth;
+
+        for (std::size_t count{}; count != 500; ++count) {
+            animray::ray<double> const r(
+                    animray::point3d<double>(
+                            place(generator), place(generator), -30),
+                    animray::point3d<double>(
+                            place(generator), place(generator), 30));
+            auto const l = linear.intersects(r, 1e-9);
+            auto const h = bvh.intersects(r, 1e-9);
+            check(l.has_value()) == h.has_value();
+            if (l and h) { animray::check_close(check, l->from, h->from); }
+            check(linear.occludes(r, 1e-9)) == bvh.occludes(r, 1e-9);
+            check(linear.occludes(r, 1e-9, 30.0))
+                    == bvh.occludes(r, 1e-9, 30.0);
+        }
+    }
+    auto const m = suite.test("matches linear scan", [](auto check) {
+        matches_linear(check, 500, 1);
+    });
+    auto const p = suite.test("parallel build", [](auto check) {
+        matches_linear(check, 5000, 4);
+    });
+    auto const pb = suite.test("pool build", [](auto check) {
+        animray::threading::pool workers{4};
+        matches_linear(check, 5000, workers);
+    });
+
+
+    using frame_ray =
+            animray::with_frame<animray::ray<double>, double>::type;
+    frame_ray at(double const frame) {
+        frame_ray r;
+        r.frame = frame;
+        return r;
+    }
+
+
+    /// Compare the animated spheres against a linear scan for rays whose
+    /// frame times come from `time`
+    template<typename C, typename S, typename T>
+    void matches_linear(C check, S const &spheres, T time) {
+        std::mt19937 generator;
+        std::uniform_real_distribution<double> place(-20, 20);
+        animray::collection<typename S::instance_type> linear;
+        for (auto const &sphere : spheres.instances) { linear.insert(sphere); }
+        for (std::size_t count{}; count != 500; ++count) {
+            frame_ray r{
+                    animray::point3d<double>(
+                            place(generator), place(generator), -30),
+                    animray::point3d<double>(
+                            place(generator), place(generator), 30)};
+            r.frame = time(generator);
+            auto const l = linear.intersects(r, 1e-9);
+            auto const h = spheres.intersects(r, 1e-9);
+            check(l.has_value()) == h.has_value();
+            if (l and h) { animray::check_close(check, l->from, h->from); }
+            check(linear.occludes(r, 1e-9)) == spheres.occludes(r, 1e-9);
+        }
+    }
+
+
+    auto const r = suite.test("refit", [](auto check) {
+        using sphere = animray::unit_sphere<animray::animate<
+                animray::animation::rotate_xy<animray::point3d<double>>>>;
+        std::mt19937 generator;
+        std::uniform_real_distribution<double> place(-15, 15), radius(1, 5),
+                speed(-1, 1), phase(0, 6);
+        animray::bvh_collection<sphere> spheres;
+        for (std::size_t count{}; count != 200; ++count) {
+            spheres.insert(sphere{
+                    {animray::point3d<double>(
+                             place(generator), place(generator), 0),
+                     radius(generator), speed(generator), phase(generator)}});
+        }
+        spheres.build(1, at(0));
+        spheres.refit(at(3));
+
+        auto rebuilt = spheres;
+        rebuilt.build(1, at(3));
+        for (std::size_t axis{}; axis < 3; ++axis) {
+            animray::check_close(
+                    check, spheres.bounds().lower[axis],
+                    rebuilt.bounds().lower[axis]);
+            animray::check_close(
+                    check, spheres.bounds().upper[axis],
+                    rebuilt.bounds().upper[axis]);
+        }
+        matches_linear(check, spheres, [](auto &) { return 3.0; });
+    });
+
+
+    /// A position moving in a straight line over time
+    struct slide {
+        using value_type = double;
+        animray::point3d<double> start, velocity;
+        animray::point3d<double> operator()(double const t) const {
+            return start + velocity * t;
+        }
+    };
+    auto const i = suite.test("interpolate unbounded", [](auto check) {
+        constexpr double inf = std::numeric_limits<double>::infinity();
+        animray::bounding_box<double> const plane{
+                {-inf, -inf, -1}, {inf, inf, 1}},
+                box{{0, 0, 0}, {2, 2, 2}};
+        auto const forward = plane.interpolate(box, 0.5);
+        check(forward.lower[0]) == -inf;
+        check(forward.upper[1]) == inf;
+        check(forward.lower[2]) == -0.5;
+        check(forward.upper[2]) == 1.5;
+        auto const backward = box.interpolate(plane, 0.5);
+        check(backward.lower[0]) == -inf;
+        check(backward.upper[1]) == inf;
+        check(backward.lower[2]) == -0.5;
+        check(backward.upper[2]) == 1.5;
+    });
+
+
+    auto const s = suite.test("refit shutter", [](auto check) {
+        using sphere = animray::unit_sphere<animray::animate<slide>>;
+        std::mt19937 generator;
+        std::uniform_real_distribution<double> place(-15, 15), speed(-4, 4);
+        animray::bvh_collection<sphere> spheres;
+        for (std::size_t count{}; count != 200; ++count) {
+            spheres.insert(sphere{
+                    {animray::point3d<double>(
+                             place(generator), place(generator), 0),
+                     animray::point3d<double>(
+                             speed(generator), speed(generator), 0)}});
+        }
+        spheres.build(1, at(0));
+        spheres.refit_shutter(at(2), at(2.5));
+        std::uniform_real_distribution<double> shutter(2, 2.5);
+        matches_linear(check, spheres, shutter);
+    });
+
+
+    auto const sr = suite.test("refit shutter rotating", [](auto check) {
+        using sphere = animray::unit_sphere<animray::animate<
+                animray::animation::rotate_xy<animray::point3d<double>>>>;
+        /// Half a turn whilst the shutter is open puts the sphere at the
+        /// top of its arc in the middle, far from both ends
+        animray::bvh_collection<sphere> half;
+        half.insert(sphere{
+                {animray::point3d<double>(0, 0, 0), 10, std::numbers::pi, 0}});
+        half.build(1, at(0));
+        half.refit_shutter(at(0), at(1));
+        frame_ray r{
+                animray::point3d<double>(0, 10, -30),
+                animray::point3d<double>(0, 10, 30)};
+        r.frame = 0.5;
+        check(half.intersects(r, 1e-9).has_value()) == true;
+        check(half.occludes(r, 1e-9)) == true;
+
+        std::mt19937 generator;
+        std::uniform_real_distribution<double> place(-15, 15), radius(1, 10),
+                speed(-3, 3), phase(0, 6);
+        animray::bvh_collection<sphere> spheres;
+        for (std::size_t count{}; count != 200; ++count) {
+            spheres.insert(sphere{
+                    {animray::point3d<double>(
+                             place(generator), place(generator), 0),
+                     radius(generator), speed(generator), phase(generator)}});
+        }
+        spheres.build(1, at(0));
+        spheres.refit_shutter(at(0), at(1));
+        std::uniform_real_distribution<double> shutter(0, 1);
+        matches_linear(check, spheres, shutter);
+    });
+
+
+}
@@ -93,4 +93,14 @@ namespace {
     });
 
 
+    auto const pb = suite.test("plane_occludes_bounded", [](auto check) {
+        animray::plane<animray::ray<int>> board;
+        animray::ray<int> const down{
+                animray::point3d(0, 0, 5), animray::point3d(0, 0, 4)};
+        check(board.occludes(down, 0, 6)).is_truthy();
+        check(board.occludes(down, 0, 5)).is_falsey();
+        check(board.occludes(down, 0, 3)).is_falsey();
+    });
+
+
 }
@@ -20,6 +20,7 @@
 
 #include <animray/functional/traits.hpp>
 #include <animray/geometry/quadrics/sphere-unit-origin.hpp>
+#include <animray/movable.hpp>
 #include <animray/ray.hpp>
 #include <felspar/test.hpp>
 
@@ -63,4 +64,32 @@ namespace {
     });
 
 
+    template<typename D, typename C>
+    void sphere_occlude_bounded(C check) {
+        using end_type = typename animray::ray<D>::end_type;
+        using ray = animray::ray<D>;
+        animray::unit_sphere_at_origin<animray::ray<D>> s;
+        check(s.occludes(ray(end_type(0, 0, 10), end_type()), 0, 20))
+                .is_truthy();
+        check(s.occludes(ray(end_type(0, 0, 10), end_type()), 0, 9))
+                .is_falsey();
+        check(s.occludes(ray(end_type(), end_type(0, 0, 10)), 0, 2))
+                .is_truthy();
+    }
+    auto const bounded = suite.test("bounded occlusion", [](auto check) {
+        sphere_occlude_bounded<int>(check);
+        sphere_occlude_bounded<float>(check);
+        sphere_occlude_bounded<double>(check);
+
+        using end_type = animray::ray<double>::end_type;
+        animray::movable<
+                animray::unit_sphere_at_origin<animray::ray<double>>>
+                large;
+        large(animray::scale(4.0, 4.0, 4.0));
+        animray::ray<double> const towards{end_type(0, 0, 10), end_type()};
+        check(large.occludes(towards, 1e-9, 7.0)).is_truthy();
+        check(large.occludes(towards, 1e-9, 5.0)).is_falsey();
+    });
+
+
 }
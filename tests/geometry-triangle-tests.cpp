@@ -22,6 +22,8 @@
 #include <animray/camera/pinhole.hpp>
 #include <animray/color/rgb.hpp>
 #include <animray/geometry/planar/triangle.hpp>
+#include <animray/geometry/planar/triangle-accelerated.hpp>
+#include <animray/geometry/planar/triangle-batch.hpp>
 #include <animray/geometry/collection.hpp>
 #include <animray/light/ambient.hpp>
 #include <animray/light/collection.hpp>
@@ -32,6 +34,8 @@
 #include <animray/test.hpp>
 #include <felspar/test.hpp>
 
+#include <random>
+
 
 namespace {
 
@@ -87,6 +91,18 @@ namespace {
                               animray::unit_vector<double>(0, 0, -1)),
                       0))
                 .is_falsey();
+        check(g.occludes(
+                      animray::ray<double>(
+                              animray::point3d<double>(1, 1, 1),
+                              animray::unit_vector<double>(0, 0, -1)),
+                      0, 2))
+                .is_truthy();
+        check(g.occludes(
+                      animray::ray<double>(
+                              animray::point3d<double>(1, 1, 1),
+                              animray::unit_vector<double>(0, 0, -1)),
+                      0, 0.5))
+                .is_falsey();
     }
 
 
@@ -109,6 +125,72 @@ namespace {
     });
 
 
+    auto const a = suite.test("accelerated", [](auto check) {
+        using triangle = animray::accelerated_triangle<animray::ray<double>>;
+        triangle const single(
+                animray::point3d<double>(0, 0, 0),
+                animray::point3d<double>(5.f, 0, 0),
+                animray::point3d<double>(0, 3.f, 0));
+        cases(check, single);
+        animray::collection<triangle> right;
+        right.insert(single);
+        cases(check, right);
+
+        animray::triangle<animray::ray<double>> const plain(
+                animray::point3d<double>(0, 0, 0),
+                animray::point3d<double>(5.f, 0, 0),
+                animray::point3d<double>(0, 3.f, 0));
+        animray::ray<double> const slanted(
+                animray::point3d<double>(-1, 2, 4),
+                animray::point3d<double>(2, 0.5, -1));
+        check(single.intersects(slanted, 0).value())
+                == plain.intersects(slanted, 0).value();
+    });
+
+
+    template<std::size_t N, typename C>
+    void batch_matches(C check) {
+        using triangle = animray::triangle<animray::ray<double>>;
+        cases(check,
+              animray::triangle_batch<animray::ray<double>, N>{}.insert(
+                      animray::point3d<double>(0, 0, 0),
+                      animray::point3d<double>(5.f, 0, 0),
+                      animray::point3d<double>(0, 3.f, 0)));
+
+        std::mt19937 generator;
+        std::uniform_real_distribution<double> place(-10, 10);
+        auto const point = [&]() {
+            return animray::point3d<double>(
+                    place(generator), place(generator), place(generator));
+        };
+        animray::collection<triangle> linear;
+        for (std::size_t count{}; count != 37; ++count) {
+            linear.insert(triangle(point(), point(), point()));
+        }
+        animray::triangle_batch<animray::ray<double>, N> const batch{
+                linear.instances};
+        check(batch.triangles()) == 37u;
+        for (std::size_t count{}; count != 500; ++count) {
+            animray::ray<double> const r(point(), point());
+            auto const l = linear.intersects(r, 1e-9);
+            auto const b = batch.intersects(r, 1e-9);
+            check(l.has_value()) == b.has_value();
+            if (l and b) {
+                animray::check_close(check, l->from, b->from);
+                check(l->direction) == b->direction;
+            }
+            check(linear.occludes(r, 1e-9)) == batch.occludes(r, 1e-9);
+            check(linear.occludes(r, 1e-9, 5.0))
+                    == batch.occludes(r, 1e-9, 5.0);
+        }
+    }
+    auto const b = suite.test("batch", [](auto check) {
+        batch_matches<1>(check);
+        batch_matches<4>(check);
+        batch_matches<8>(check);
+    });
+
+
     auto const fs = suite.test("full scene", [](auto check) {
         typedef double world;
         typedef animray::triangle<animray::ray<world>> triangle;
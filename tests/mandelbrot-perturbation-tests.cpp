@@ -0,0 +1,152 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/film.hpp>
+#include <animray/mandelbrot/perturbation.hpp>
+#include <felspar/test.hpp>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    using film_type = animray::film<std::uint16_t>;
+    using animray::fixed_point;
+    auto const counter = [](unsigned int d, std::size_t) {
+        return std::uint16_t(d);
+    };
+
+
+    auto const rebase = suite.test("short reference", [](auto check) {
+        /// The orbit of 1 escapes at its third point, so pixels that last
+        /// longer have to be rebased onto the start of it
+        animray::mandelbrot::reference_orbit const orbit{
+                fixed_point{1.0L, 2}, fixed_point{0.0L, 2}, 2, 100};
+        check(orbit.x.size()) == 3u;
+        check(orbit.escape_time(0, 0, 100)) == 1u;
+        check(orbit.escape_time(-1, 0, 100)) == 100u;
+        check(orbit.escape_time(-2, 0, 100)) == 100u;
+        check(orbit.escape_time(-3, 0, 100)) == 0u;
+        check(orbit.escape_time(-1, 1, 100)) == 100u;
+        check(orbit.escape_time(-2, 1, 100)) == 2u;
+    });
+
+
+    auto const shallow = suite.test("matches long double", [](auto check) {
+        animray::mandelbrot::transformer<film_type, long double> const
+                direct{64, 48, -0.7435L, 0.1314L, 2e-3L, 10, counter};
+        animray::mandelbrot::perturbation<film_type> const perturbed{
+                64,
+                48,
+                fixed_point{"-0.7435", 4},
+                fixed_point{"0.1314", 4},
+                2e-3,
+                10,
+                counter};
+        film_type const expected{64, 48, direct};
+        film_type image{64, 48, std::uint16_t{}};
+        perturbed.fill(image);
+        std::size_t differ{};
+        for (std::size_t y{}; y != 48; ++y) {
+            for (std::size_t x{}; x != 64; ++x) {
+                differ += (image.pixel(x, y) != expected.pixel(x, y));
+            }
+        }
+        check(differ) < 64u * 48u / 100u;
+    });
+
+
+    auto const deep = suite.test("deep zoom", [](auto check) {
+        /// The Misiurewicz point at `i` has structure at every scale. The
+        /// image must show a spread of escape times and agree with the
+        /// pixels worked out directly with a `fixed_point`
+        std::size_t const limbs = fixed_point::limbs_for(300);
+        animray::mandelbrot::perturbation<film_type> const perturbed{
+                32, 32, fixed_point{0.0L, limbs}, fixed_point{1.0L, limbs},
+                1e-60, 10, counter};
+        film_type image{32, 32, std::uint16_t{}};
+        perturbed.fill(image);
+        std::uint16_t low = 0xffff, high{};
+        for (std::size_t y{}; y != 32; ++y) {
+            for (std::size_t x{}; x != 32; ++x) {
+                low = std::min(low, image.pixel(x, y));
+                high = std::max(high, image.pixel(x, y));
+            }
+        }
+        check(high - low) > 5;
+
+        auto const exact = [&](std::size_t const px, std::size_t const py) {
+            fixed_point const step{1e-60L / 32, limbs};
+            fixed_point const cx =
+                    fixed_point{double(px) - 16.0, limbs} * step;
+            fixed_point const cy = fixed_point{1.0L, limbs}
+                    + fixed_point{double(py) - 16.0, limbs} * step;
+            animray::mandelbrot::reference_orbit const orbit{
+                    cx, cy, limbs, 1023};
+            double const x = orbit.x.back(), y = orbit.y.back();
+            std::size_t const count =
+                    x * x + y * y >= 4 ? orbit.x.size() - 2 : 1023;
+            return std::uint16_t(count < 1023 ? count + 1 : 0);
+        };
+        check(image.pixel(0, 0)) == exact(0, 0);
+        check(image.pixel(31, 7)) == exact(31, 7);
+        check(image.pixel(5, 29)) == exact(5, 29);
+    });
+
+
+    auto const series = suite.test("series approximation", [](auto check) {
+        std::size_t const limbs = fixed_point::limbs_for(300);
+        animray::mandelbrot::perturbation<film_type> const perturbed{
+                32, 32, fixed_point{0.0L, limbs}, fixed_point{1.0L, limbs},
+                1e-60, 10, counter};
+        auto const &orbit = *perturbed.orbit;
+        auto const &approximation = perturbed.series;
+        check(approximation.skip) > 100u;
+
+        /// The polynomial matches iterating the corner pixel directly
+        std::complex<double> const dc{
+                -16 * perturbed.per_pixel, -16 * perturbed.per_pixel};
+        std::complex<double> d{};
+        for (std::size_t n{}; n != approximation.skip; ++n) {
+            d = (2.0 * std::complex<double>{orbit.x[n], orbit.y[n]} + d) * d
+                    + dc;
+        }
+        check(std::abs(approximation(dc) - d)) < 1e-9 * std::abs(d);
+
+        /// Skipping makes no difference to the image
+        std::size_t differ{};
+        for (std::size_t y{}; y != 32; ++y) {
+            for (std::size_t x{}; x != 32; ++x) {
+                std::size_t const count = orbit.escape_time(
+                        (double(x) - 16) * perturbed.per_pixel,
+                        (double(y) - 16) * perturbed.per_pixel,
+                        perturbed.limit());
+                std::uint16_t const expected =
+                        count < perturbed.limit() ? count + 1 : 0;
+                differ += (perturbed(x, y) != expected);
+            }
+        }
+        check(differ) == 0u;
+    });
+
+
+}
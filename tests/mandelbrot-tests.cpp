@@ -0,0 +1,179 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/film.hpp>
+#include <animray/mandelbrot.hpp>
+#include <felspar/test.hpp>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    using film_type = animray::film<std::uint16_t>;
+    using transformer =
+            animray::mandelbrot::transformer<film_type, long double>;
+    auto const counter = [](unsigned int d, std::size_t) {
+        return std::uint16_t(d);
+    };
+
+
+    film_type per_pixel(transformer const &t) {
+        return film_type{t.width, t.height, t};
+    }
+    std::size_t differences(film_type const &a, film_type const &b) {
+        std::size_t count{};
+        for (std::size_t y{}; y != a.height(); ++y) {
+            for (std::size_t x{}; x != a.width(); ++x) {
+                count += (a.pixel(x, y) != b.pixel(x, y));
+            }
+        }
+        return count;
+    }
+
+
+    auto const escape = suite.test("escape times", [](auto check) {
+        std::array<float, 4> const x{0, 2, 1, -1}, y{0, 0, 0, 0};
+        auto const counts = animray::mandelbrot::escape_times(x, y, 100);
+        check(counts[0]) == 100u;
+        check(counts[1]) == 0u;
+        check(counts[2]) == 1u;
+        check(counts[3]) == 100u;
+    });
+
+
+    auto const interior = suite.test("interior", [](auto check) {
+        using animray::mandelbrot::in_main_bulbs;
+        check(in_main_bulbs(0.0, 0.0)).is_truthy();
+        check(in_main_bulbs(0.2, 0.5)).is_truthy();
+        check(in_main_bulbs(-1.1, 0.2)).is_truthy();
+        check(in_main_bulbs(0.3, 0.0)).is_falsey();
+        check(in_main_bulbs(-0.12, 0.75)).is_falsey();
+
+        /// The interior of the Douady rabbit has period three, so is found
+        /// by the cycle check rather than the bulbs
+        std::array<double, 4> const x{-0.12, -0.12, -1.3, 0.3},
+                y{0.75, 0.76, 0, 0};
+        auto const counts = animray::mandelbrot::escape_times(x, y, 5000);
+        check(counts[0]) == 5000u;
+        check(counts[1]) == 5000u;
+        check(counts[2]) == 5000u;
+        check(counts[3]) == 11u;
+
+        /// A plain loop gives the same counts across the whole set
+        std::size_t differ{};
+        for (double cy = -1.2; cy < 1.2; cy += 0.05) {
+            for (double cx = -2.1; cx < 0.6; cx += 0.05) {
+                std::array<double, 1> const px{cx}, py{cy};
+                std::size_t const count =
+                        animray::mandelbrot::escape_times(px, py, 1000)[0];
+                double zx = cx, zy = cy;
+                std::size_t plain{};
+                while (plain != 1000 and zx * zx + zy * zy < 4) {
+                    double const x2 = zx * zx - zy * zy + cx;
+                    zy = 2 * zx * zy + cy;
+                    zx = x2;
+                    ++plain;
+                }
+                differ += (count != plain);
+            }
+        }
+        check(differ) == 0u;
+    });
+
+
+    auto const lanes = suite.test("lanes", [](auto check) {
+        transformer const t{37, 23, -0.5L, 0.1L, 2.5L, 8, counter};
+        auto const expected = per_pixel(t);
+        film_type one{37, 23, std::uint16_t{}}, four{37, 23, std::uint16_t{}};
+        t.fill_lanes<long double, 1>(one);
+        t.fill_lanes<long double, 4>(four);
+        check(differences(expected, one)) == 0u;
+        check(differences(expected, four)) == 0u;
+    });
+
+
+    auto const precision = suite.test("precision", [](auto check) {
+        transformer const wide{80, 60, -0.5L, 0.0L, 3.0L, 10, counter};
+        check(animray::mandelbrot::enough_precision<float>(
+                wide.per_pixel, 2.0L))
+                == true;
+        film_type fast{80, 60, std::uint16_t{}};
+        wide.fill(fast);
+        check(differences(per_pixel(wide), fast)) < 80u * 60u / 100u;
+
+        transformer const deep{
+                40, 30, -0.743643887037151L, 0.131825904205330L, 1e-13L, 10,
+                counter};
+        check(animray::mandelbrot::enough_precision<double>(
+                deep.per_pixel, 1.0L))
+                == false;
+        film_type exact{40, 30, std::uint16_t{}};
+        deep.fill(exact);
+        check(differences(per_pixel(deep), exact)) == 0u;
+    });
+
+
+    auto const subdivide = suite.test("subdivide", [](auto check) {
+        for (auto const diameter : {3.0L, 0.5L, 0.01L}) {
+            transformer const t{
+                    97, 61, -0.75L, 0.1L, diameter, 10, counter};
+            film_type filled{97, 61, std::uint16_t{}},
+                    divided{97, 61, std::uint16_t{}};
+            t.fill(filled);
+            t.subdivide(divided.region(divided.size()));
+            check(differences(filled, divided)) == 0u;
+
+            /// A region away from the corner of the film
+            film_type part{97, 61, std::uint16_t{7}};
+            t.subdivide(part.region({20, 10, 70, 50}));
+            std::size_t outside{}, inside{};
+            for (std::size_t y{}; y != 61; ++y) {
+                for (std::size_t x{}; x != 97; ++x) {
+                    if (x >= 20 and x <= 70 and y >= 10 and y <= 50) {
+                        inside += (part.pixel(x, y) != filled.pixel(x, y));
+                    } else {
+                        outside += (part.pixel(x, y) != 7);
+                    }
+                }
+            }
+            check(inside) == 0u;
+            check(outside) == 0u;
+        }
+    });
+
+
+    auto const zoomed_out = suite.test("subdivide whole set", [](auto check) {
+        /// The set is small enough to sit inside rectangles whose edges all
+        /// escape at the same time
+        for (auto const diameter : {8.0L, 20.0L, 40.0L}) {
+            transformer const t{100, 100, 0.0L, 0.0L, diameter, 8, counter};
+            film_type filled{100, 100, std::uint16_t{}},
+                    divided{100, 100, std::uint16_t{}};
+            t.fill(filled);
+            t.subdivide(divided.region(divided.size()));
+            check(differences(filled, divided)) == 0u;
+        }
+    });
+
+
+}
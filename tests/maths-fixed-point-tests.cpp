@@ -0,0 +1,114 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/maths/fixed-point.hpp>
+#include <felspar/test.hpp>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    using animray::fixed_point;
+
+
+    auto const conversion = suite.test("conversion", [](auto check) {
+        check(double(fixed_point{1.5L, 2})) == 1.5;
+        check(double(fixed_point{-0.25L, 2})) == -0.25;
+        check(double(fixed_point{-3.0L, 1})) == -3.0;
+        check(double(fixed_point{0.1L, 3})) == 0.1;
+        check(double(fixed_point{std::ldexp(1.0L, -90), 3}))
+                == std::ldexp(1.0, -90);
+        check(double(fixed_point{2147483647.5L, 2})) == 2147483647.5;
+        check([]() { fixed_point{3e9L, 2}; })
+                .throws(std::out_of_range{
+                        "Too large for a fixed point number: "
+                        + std::to_string(3e9L)});
+        check([]() { fixed_point{-1e10L, 2}; })
+                .throws(std::out_of_range{
+                        "Too large for a fixed point number: "
+                        + std::to_string(-1e10L)});
+    });
+
+
+    auto const parse = suite.test("parse", [](auto check) {
+        check(double(fixed_point{"1.5", 2})) == 1.5;
+        check(double(fixed_point{"-0.25", 2})) == -0.25;
+        check(double(fixed_point{"+12", 2})) == 12.0;
+        check(double(fixed_point{"0.1", 4})) == 0.1;
+        check(double(fixed_point{"-1.75", 4})) == -1.75;
+        check(double(fixed_point{"1.2e3", 2})) == 1200.0;
+        check(double(fixed_point{"-25E-2", 2})) == -0.25;
+        check(double(fixed_point{"0.0125e+2", 4})) == 1.25;
+        check(double(fixed_point{"1e-1000", 4})) == 0.0;
+        /// The digits are truncated past the last limb
+        check(std::abs(double(fixed_point{"1e-5", 4}) / 1e-5 - 1)) < 1e-15;
+        check(std::abs(double(fixed_point{"-7.5e-30", 8}) / -7.5e-30 - 1))
+                < 1e-15;
+        check([]() { fixed_point{"1.2f3", 2}; })
+                .throws(std::invalid_argument{"Not a decimal number: 1.2f3"});
+        check([]() { fixed_point{"1.2e", 2}; })
+                .throws(std::invalid_argument{"Not a decimal number: 1.2e"});
+        check(double(fixed_point{"0e20", 2})) == 0.0;
+        check(double(fixed_point{"2147483647.5", 2})) == 2147483647.5;
+        check(double(fixed_point{"-0002147483647", 2})) == -2147483647.0;
+        for (auto const text :
+             {"1e20", "1e10", "3000000000", "12345678901234", "2147483648",
+              "-2147483648.5", "214748364.8e1"}) {
+            check([text]() { fixed_point{text, 2}; })
+                    .throws(std::out_of_range{
+                            "Too large for a fixed point number: "
+                            + std::string{text}});
+        }
+    });
+
+
+    auto const arithmetic = suite.test("arithmetic", [](auto check) {
+        fixed_point const a{1.25L, 2}, b{-3.5L, 2};
+        check(double(a + b)) == -2.25;
+        check(double(a - b)) == 4.75;
+        check(double(-b)) == 3.5;
+        check(double(a * b)) == -4.375;
+        check(double(b * b)) == 12.25;
+        /// Mixed precision takes the larger
+        fixed_point const c{0.5L, 6};
+        check((a * c).fraction_limbs()) == 6u;
+        check(double(a * c)) == 0.625;
+    });
+
+
+    auto const precise = suite.test("precision", [](auto check) {
+        /// (1 + 2^-200)^2 - 1 is 2^-199 + 2^-400, and is well past what a
+        /// `long double` can see
+        fixed_point const one{1.0L, 8};
+        fixed_point const x = one + fixed_point{std::ldexp(1.0L, -200), 8};
+        check(double(x * x - one)) == std::ldexp(1.0, -199);
+        /// A tenth can't be held exactly, but ten of them come to one less
+        /// the last bit or so
+        fixed_point const tenth{"0.1", 8}, ten{10.0L, 8};
+        double const error = double(one - ten * tenth);
+        check(error) >= 0.0;
+        check(error) < 1e-75;
+    });
+
+
+}
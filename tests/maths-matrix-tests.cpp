@@ -25,6 +25,8 @@
 #include <animray/test.hpp>
 #include <felspar/test.hpp>
 
+#include <sstream>
+
 
 namespace {
 
@@ -105,4 +107,56 @@ namespace {
     });
 
 
+
+    static_assert(animray::Regular<animray::affine_matrix<float>>);
+    using point = animray::point3d<double>;
+
+
+    auto const am = suite.test("affine matches matrix", [](auto check) {
+        auto const t = animray::translate<double>(1, -2, 3);
+        auto const r = animray::rotate_y<double>(30_deg);
+        auto const s = animray::scale<double>(2, 1, 0.5);
+        animray::affine_matrix<double> const a =
+                t.forward() * r.first * s.first;
+        animray::matrix<double> const m = animray::matrix<double>{t.forward()}
+                * animray::matrix<double>{r.first}
+                * animray::matrix<double>{s.first};
+        check(animray::matrix<double>{a}) == m;
+
+        point const p(1, 2, 3);
+        auto const pa = a * p, pm = m * p;
+        animray::check_close(check, pa.x(), pm.x(), 1e-10);
+        animray::check_close(check, pa.y(), pm.y(), 1e-10);
+        animray::check_close(check, pa.z(), pm.z(), 1e-10);
+
+        animray::vec3<double> const v = a * animray::vec3<double>{p};
+        animray::check_close(check, v.x(), pm.x(), 1e-10);
+        animray::check_close(check, v.y(), pm.y(), 1e-10);
+        animray::check_close(check, v.z(), pm.z(), 1e-10);
+    });
+
+
+    auto const ad = suite.test("affine direction", [](auto check) {
+        auto const t = animray::translate<double>(10, 20, 30);
+        animray::unit_vector<double> const x(1, 0, 0);
+        check(point(t.forward().direction(x))) == point(1, 0, 0);
+
+        animray::ray<double> const along(point(0, 0, 0), point(0, 0, 1));
+        auto const s = animray::scale<double>(1, 1, 4);
+        auto const moved = along * s.first;
+        check(moved.direction) == along.direction;
+        check(animray::transform_distance(along, s.first, 2.0)) == 8.0;
+        check(animray::transform_distance(
+                along, animray::matrix<double>{s.first}, 2.0))
+                == 8.0;
+    });
+
+
+    auto const ap = suite.test("affine print", [](auto check) {
+        std::ostringstream out;
+        out << animray::translate<double>(1, -2, 3.5).forward();
+        check(out.str())
+                == "(1, 0, 0, 1)\n(0, 1, 0, -2)\n(0, 0, 1, 3.5)\n";
+    });
+
 }
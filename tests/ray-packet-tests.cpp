@@ -0,0 +1,151 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/affine.hpp>
+#include <animray/camera/pinhole.hpp>
+#include <animray/compound.hpp>
+#include <animray/geometry/collection.hpp>
+#include <animray/geometry/planar/plane.hpp>
+#include <animray/geometry/planar/triangle.hpp>
+#include <animray/geometry/quadrics/sphere-unit-origin.hpp>
+#include <animray/movable.hpp>
+#include <animray/ray-packet.hpp>
+#include <animray/surface.hpp>
+#include <animray/test.hpp>
+#include <felspar/test.hpp>
+
+#include <random>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    using ray = animray::ray<double>;
+    using point = animray::point3d<double>;
+
+
+    auto const lanes = suite.test("lanes", [](auto check) {
+        animray::ray_packet<double, 4> packet;
+        check(animray::any(packet.active)).is_falsey();
+        ray const r{point(1, 2, 3), point(1, 2, 4)};
+        packet.set(2, r);
+        check(animray::any(packet.active)).is_truthy();
+        check(packet.active[2]).is_truthy();
+        check(packet[2]) == r;
+    });
+
+
+    /// Compare packets of `N` random rays against the geometry with the same
+    /// rays one at a time
+    template<std::size_t N, typename C, typename G>
+    void matches_scalar(C check, G const &geometry) {
+        std::mt19937 generator;
+        std::uniform_real_distribution<double> place(-10, 10);
+        std::uniform_int_distribution<int> coin(0, 3);
+        for (std::size_t count{}; count != 100; ++count) {
+            animray::ray_packet<double, N> packet;
+            std::array<double, N> t_max;
+            for (std::size_t lane{}; lane < N; ++lane) {
+                if (coin(generator)) {
+                    packet.set(
+                            lane,
+                            ray{point(place(generator), place(generator),
+                                      place(generator)),
+                                point(place(generator) / 5,
+                                      place(generator) / 5,
+                                      place(generator) / 5)});
+                }
+                t_max[lane] = place(generator) + 10;
+            }
+            animray::packet_intersection<typename G::intersection_type, N>
+                    closest;
+            geometry.intersects(packet, 1e-9, closest);
+            auto const blocked = geometry.occludes(packet, 1e-9, t_max);
+            for (std::size_t lane{}; lane < N; ++lane) {
+                if (packet.active[lane]) {
+                    auto const hit = geometry.intersects(packet[lane], 1e-9);
+                    check(closest.hit[lane].has_value()) == hit.has_value();
+                    if (hit and closest.hit[lane]) {
+                        animray::check_close(
+                                check, closest.hit[lane]->from, hit->from);
+                    }
+                    check(blocked[lane])
+                            == geometry.occludes(
+                                    packet[lane], 1e-9, t_max[lane]);
+                } else {
+                    check(closest.hit[lane].has_value()).is_falsey();
+                    check(blocked[lane]).is_falsey();
+                }
+            }
+        }
+    }
+
+
+    auto const primitives = suite.test("primitives", [](auto check) {
+        matches_scalar<4>(check, animray::unit_sphere_at_origin<ray>{});
+        matches_scalar<8>(
+                check,
+                animray::triangle<ray>{
+                        point(-3, -3, 0), point(3, -3, 1), point(0, 4, -1)});
+        matches_scalar<4>(
+                check,
+                animray::plane<ray>{
+                        point(0, 0, 2), animray::unit_vector<double>(0, 1, 0)});
+    });
+
+
+    auto const collections = suite.test("collections", [](auto check) {
+        using sphere = animray::movable<animray::unit_sphere_at_origin<ray>>;
+        animray::collection<sphere> spheres;
+        spheres.insert(sphere{}(animray::translate<double>(2, 0, 0)));
+        spheres.insert(sphere{}(animray::scale<double>(3, 1, 2)));
+        spheres.insert(sphere{}(animray::translate<double>(-4, 2, 1)));
+        matches_scalar<4>(check, spheres);
+
+        using triangle = animray::surface<animray::triangle<ray>>;
+        animray::compound<animray::collection<sphere>, triangle> both{
+                spheres,
+                triangle{animray::triangle<ray>{
+                        point(-6, -6, 3), point(6, -6, 3), point(0, 6, 3)}}};
+        matches_scalar<16>(check, both);
+    });
+
+
+    auto const camera = suite.test("camera", [](auto check) {
+        animray::movable<animray::pinhole_camera<ray>, ray> camera(
+                0.036, 0.024, 30, 20, 0.05);
+        camera(animray::translate<double>(1, 2, -8));
+        auto const packet = camera.packet<4, 2>(10, 5);
+        for (std::size_t row{}; row < 2; ++row) {
+            for (std::size_t column{}; column < 4; ++column) {
+                auto const r = packet[row * 4 + column];
+                auto const expected = camera(10 + column, 5 + row);
+                animray::check_close(check, r.from, expected.from);
+                animray::check_close(
+                        check, r.ends(), expected.ends(), 1e-6);
+            }
+        }
+    });
+
+
+}
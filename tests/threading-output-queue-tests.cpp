@@ -0,0 +1,81 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/threading/output-queue.hpp>
+#include <felspar/test.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    auto const order = suite.test("order", [](auto check) {
+        std::vector<int> done;
+        {
+            animray::threading::output_queue queue{3};
+            for (int job{}; job != 20; ++job) {
+                queue.push([&done, job]() { done.push_back(job); });
+            }
+        }
+        check(done.size()) == 20u;
+        for (int job{}; job != 20; ++job) { check(done[job]) == job; }
+    });
+
+
+    auto const bounded = suite.test("back pressure", [](auto check) {
+        animray::threading::output_queue queue{2};
+        std::promise<void> release;
+        auto const blocked = release.get_future().share();
+        std::atomic<bool> pushed{};
+        queue.push([blocked]() { blocked.wait(); });
+        queue.push([]() {});
+        auto third = std::async(std::launch::async, [&]() {
+            queue.push([]() {});
+            pushed = true;
+        });
+        check(third.wait_for(std::chrono::milliseconds{50}))
+                == std::future_status::timeout;
+        check(pushed.load()) == false;
+        release.set_value();
+        third.get();
+        queue.flush();
+        check(pushed.load()) == true;
+    });
+
+
+    auto const error = suite.test("error", [](auto check) {
+        animray::threading::output_queue queue;
+        queue.push([]() { throw std::runtime_error{"Write"}; });
+        check([&]() { queue.flush(); }).throws(std::runtime_error{"Write"});
+        int ran{};
+        queue.push([&ran]() { ++ran; });
+        queue.flush();
+        check(ran) == 1;
+    });
+
+
+}
@@ -0,0 +1,127 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/threading/sub-panel.hpp>
+#include <felspar/test.hpp>
+
+#include <atomic>
+#include <deque>
+#include <stdexcept>
+#include <thread>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    auto const submit = suite.test("submit", [](auto check) {
+        animray::threading::pool workers{3};
+        check(workers.size()) == 3u;
+        std::vector<std::future<std::size_t>> results;
+        for (std::size_t job{}; job != 100; ++job) {
+            results.push_back(workers.submit([job]() { return job * job; }));
+        }
+        for (std::size_t job{}; job != 100; ++job) {
+            check(workers.wait(std::move(results[job]))) == job * job;
+        }
+    });
+
+
+    std::size_t fibonacci(animray::threading::pool &workers, std::size_t n) {
+        if (n < 2) { return n; }
+        auto left = workers.submit(
+                [&workers, n]() { return fibonacci(workers, n - 1); });
+        auto const right = fibonacci(workers, n - 2);
+        return workers.wait(std::move(left)) + right;
+    }
+    auto const counted = suite.test("queued count", [](auto check) {
+        /// Jobs are taken as soon as they are posted, so the count must
+        /// never drop below zero and wrap
+        animray::threading::pool workers{2};
+        std::atomic<bool> posting{true};
+        std::thread poster{[&]() {
+            for (std::size_t job{}; job != 20000; ++job) {
+                workers.post([]() {});
+            }
+            posting = false;
+        }};
+        std::size_t largest{};
+        while (posting) {
+            largest = std::max(largest, workers.queued_jobs());
+        }
+        poster.join();
+        check(largest) <= 20000u;
+    });
+
+
+    auto const nested = suite.test("nested", [](auto check) {
+        for (std::size_t const threads : {0u, 1u, 4u}) {
+            animray::threading::pool workers{threads};
+            check(workers.wait(workers.submit(
+                    [&workers]() { return fibonacci(workers, 15); })))
+                    == 610u;
+        }
+    });
+
+
+    auto const error = suite.test("error", [](auto check) {
+        animray::threading::pool workers{2};
+        auto result = workers.submit([]() -> int {
+            throw std::runtime_error{"Job"};
+        });
+        check([&]() { workers.wait(std::move(result)); })
+                .throws(std::runtime_error{"Job"});
+        check(workers.wait(workers.submit([]() { return 3; }))) == 3;
+    });
+
+
+    auto const frames = suite.test("overlapping frames", [](auto check) {
+        animray::threading::pool workers{4};
+        std::deque<animray::threading::sub_panel_progress> progress;
+        std::vector<std::future<animray::film<std::size_t>>> rendered;
+        for (std::size_t frame{}; frame != 3; ++frame) {
+            auto &p = progress.emplace_back(60, 40);
+            rendered.push_back(
+                    animray::threading::sub_panel<animray::film<std::size_t>>(
+                            workers, p, 60, 40,
+                            [frame](std::size_t x, std::size_t y) {
+                                return frame * 10000 + y * 100 + x;
+                            }));
+        }
+        for (std::size_t frame{}; frame != 3; ++frame) {
+            auto const image = rendered[frame].get();
+            check(progress[frame].count.load())
+                    == progress[frame].count_limit;
+            std::size_t wrong{};
+            for (std::size_t y{}; y < 40; ++y) {
+                for (std::size_t x{}; x < 60; ++x) {
+                    if (image[x][y] != frame * 10000 + y * 100 + x) {
+                        ++wrong;
+                    }
+                }
+            }
+            check(wrong) == 0u;
+        }
+    });
+
+
+}
@@ -0,0 +1,186 @@
+/**
+    Copyright 2010-2021, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include <animray/threading/sub-panel.hpp>
+#include <felspar/test.hpp>
+
+#include <array>
+#include <stdexcept>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    auto const region = suite.test("film region", [](auto check) {
+        animray::film<std::size_t> image{6, 4};
+        image.region({2, 1, 4, 2}).fill(
+                [](std::size_t x, std::size_t y) { return y * 10 + x; });
+        check(image[1][1]) == 0u;
+        check(image[2][1]) == 12u;
+        check(image[4][2]) == 24u;
+        check(image[5][2]) == 0u;
+        check(image[3][3]) == 0u;
+
+        animray::film<std::size_t, std::size_t, animray::layout::tiled<2>>
+                tiled{5, 5};
+        tiled.region({1, 1, 3, 3}).fill(
+                [](std::size_t x, std::size_t y) { return y * 10 + x; });
+        check(tiled[3][3]) == 33u;
+        check(tiled[4][4]) == 0u;
+    });
+
+
+    auto const tiles = suite.test("tile sizes", [](auto check) {
+        using extents = animray::film<int>::extents_type;
+        for (auto const [w, h, threads] :
+             {std::array<std::size_t, 3>{127, 61, 4},
+              std::array<std::size_t, 3>{1920, 1080, 8},
+              std::array<std::size_t, 3>{7, 5, 1}}) {
+            animray::threading::sub_panel_progress const progress{
+                    w, h, threads};
+            constexpr auto alignment =
+                    animray::threading::sub_panel_progress::tile_alignment;
+            check(progress.panel_size_x % alignment == 0
+                  or progress.panel_size_x == w)
+                    == true;
+            check(progress.panel_size_y % alignment == 0
+                  or progress.panel_size_y == h)
+                    == true;
+            check(progress.count_limit)
+                    <= 2 * threads
+                            * animray::threading::sub_panel_progress::
+                                    tiles_per_thread;
+            check(progress.order.size()) == progress.count_limit;
+
+            animray::film<int> covered{w, h};
+            for (auto const tile : progress.order) {
+                auto const area = progress.panel<extents>(tile);
+                for (auto y = area.lower_left.y; y <= area.top_right.y; ++y) {
+                    for (auto x = area.lower_left.x; x <= area.top_right.x;
+                         ++x) {
+                        ++covered[x][y];
+                    }
+                }
+            }
+            std::size_t wrong{};
+            covered.for_each([&](int const c) {
+                if (c != 1) { ++wrong; }
+            });
+            check(wrong) == 0u;
+
+            auto const first = progress.panel<extents>(progress.order[0]);
+            check(first.lower_left.x) <= w / 2;
+            check(first.top_right.x) >= w / 2;
+            check(first.lower_left.y) <= h / 2;
+            check(first.top_right.y) >= h / 2;
+        }
+    });
+
+
+    auto const render = suite.test("sub panel", [](auto check) {
+        for (std::size_t const threads : {0u, 1u, 4u}) {
+            animray::threading::sub_panel_progress progress{120, 80};
+            auto const image =
+                    animray::threading::sub_panel<animray::film<std::size_t>>(
+                            progress, threads, 120, 80,
+                            [](std::size_t x, std::size_t y) {
+                                return y * 1000 + x;
+                            });
+            check(progress.count.load()) == progress.count_limit;
+            std::size_t wrong{};
+            for (std::size_t y{}; y < 80; ++y) {
+                for (std::size_t x{}; x < 120; ++x) {
+                    if (image[x][y] != y * 1000 + x) { ++wrong; }
+                }
+            }
+            check(wrong) == 0u;
+        }
+    });
+
+
+    auto const uneven = suite.test("uneven cost", [](auto check) {
+        animray::threading::pool workers{4};
+        animray::threading::sub_panel_progress progress{96, 64, 4};
+        auto const image = workers.wait(
+                animray::threading::sub_panel<animray::film<std::size_t>>(
+                        workers, progress, 96, 64,
+                        [](std::size_t x, std::size_t y) {
+                            std::size_t value = y * 1000 + x;
+                            if (x > 40 and x < 56 and y > 24 and y < 40) {
+                                for (std::size_t i{}; i != 20000; ++i) {
+                                    value = value * 3 % 1000003;
+                                }
+                                value = y * 1000 + x;
+                            }
+                            return value;
+                        }));
+        check(progress.count.load()) == progress.count_limit;
+        std::size_t wrong{};
+        for (std::size_t y{}; y < 64; ++y) {
+            for (std::size_t x{}; x < 96; ++x) {
+                if (image[x][y] != y * 1000 + x) { ++wrong; }
+            }
+        }
+        check(wrong) == 0u;
+    });
+
+
+    auto const regions = suite.test("sub panel regions", [](auto check) {
+        animray::threading::sub_panel_progress progress{120, 80, 4};
+        std::atomic<std::size_t> calls{};
+        auto const image =
+                animray::threading::sub_panel<animray::film<std::size_t>>(
+                        progress, 4, 120, 80,
+                        [&](animray::film<std::size_t>::region_view const
+                                    &region) {
+                            ++calls;
+                            region.fill([](std::size_t x, std::size_t y) {
+                                return y * 1000 + x;
+                            });
+                        });
+        check(progress.count.load()) == progress.count_limit;
+        check(calls.load()) == progress.count_limit;
+        std::size_t wrong{};
+        for (std::size_t y{}; y < 80; ++y) {
+            for (std::size_t x{}; x < 120; ++x) {
+                if (image[x][y] != y * 1000 + x) { ++wrong; }
+            }
+        }
+        check(wrong) == 0u;
+    });
+
+
+    auto const error = suite.test("sub panel error", [](auto check) {
+        check([]() {
+            animray::threading::sub_panel_progress progress{40, 40};
+            animray::threading::sub_panel<animray::film<int>>(
+                    progress, 4, 40, 40, [](std::size_t x, std::size_t) {
+                        if (x == 17) { throw std::runtime_error{"Pixel"}; }
+                        return 0;
+                    });
+        }).throws(std::runtime_error{"Pixel"});
+    });
+
+
+}
@@ -0,0 +1,143 @@
+/**
+    Copyright 2026, [Kirit Saelensminde](https://kirit.com/AnimRay).
+
+    This file is part of AnimRay.
+
+    AnimRay is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    AnimRay is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with AnimRay.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <animray/affine.hpp>
+#include <animray/functional/traits.hpp>
+#include <animray/geometry/planar/plane.hpp>
+#include <animray/geometry/planar/triangle.hpp>
+#include <animray/geometry/quadrics/sphere-unit-origin.hpp>
+#include <animray/movable.hpp>
+#include <animray/vec3.hpp>
+#include <felspar/test.hpp>
+
+#include <random>
+
+
+namespace {
+
+
+    auto const suite = felspar::testsuite(__FILE__);
+
+
+    static_assert(animray::Regular<animray::vec3<float>>);
+    static_assert(animray::Regular<animray::vec3<double>>);
+    static_assert(animray::Regular<animray::unit_vec3<double>>);
+    static_assert(alignof(animray::vec3<float>) == 16);
+    static_assert(sizeof(animray::vec3<float>) == 16);
+
+
+    using vec = animray::vec3<double>;
+    using point = animray::point3d<double>;
+    using slow_ray = animray::ray<double>;
+    using unit = animray::unit_vec3<double>;
+    using fast_ray = animray::ray<double, vec, unit>;
+
+
+    auto const ba = suite.test("basic arithmatic", [](auto check) {
+        vec const x(1, 0, 0), y(0, 1, 0), z(0, 0, 1);
+        check(x + y) == vec(1, 1, 0);
+        check(x - z) == vec(1, 0, -1);
+        check(-y) == vec(0, -1, 0);
+        check(x * 2) == vec(2, 0, 0);
+        check(animray::cross(x, y)) == z;
+        check(animray::dot(x + y, y + z)) == 1.0;
+        check(vec(3, 4, 12).magnitude()) == 13.0;
+        check(vec(0, 0, 5).unit()) == z;
+        check(unit{vec(0, -2, 0)}) == -y;
+    });
+
+
+    auto const conv = suite.test("conversions", [](auto check) {
+        point const p(2, 4, 6, 2);
+        check(vec{p}) == vec(1, 2, 3);
+        check(point{vec{p}}) == p;
+        animray::unit_vector<double> const u(0, 3, 0, 3);
+        check(vec{u}) == vec(0, 1, 0);
+        check(animray::unit_vector<double>{unit{u}}) == u;
+
+        auto const m = animray::translate<double>(1, 2, 3).forward();
+        check(m * vec(1, 1, 1)) == vec(m * point(1, 1, 1));
+    });
+
+
+    /// Fire random rays at the geometry as both `point3d` rays and `vec3`
+    /// rays and check that they agree
+    template<typename S, typename F>
+    void matches(auto check, S const &slow, F const &fast) {
+        std::mt19937 rng{};
+        std::uniform_real_distribution<double> distribution{-3, 3};
+        auto const random = [&]() {
+            return point(
+                    distribution(rng), distribution(rng), distribution(rng));
+        };
+        for (std::size_t count{}; count < 200; ++count) {
+            point const from = random(), to = random();
+            slow_ray const sr{from, to};
+            fast_ray const fr{vec{from}, vec{to}};
+            auto const s = slow.intersects(sr, 1e-9);
+            auto const f = fast.intersects(fr, 1e-9);
+            check(bool(f)) == bool(s);
+            if (s and f) {
+                check((vec{s->from} - f->from).magnitude() < 1e-9)
+                        .is_truthy();
+                check((vec{s->direction} - f->direction).magnitude()
+                      < 1e-9)
+                        .is_truthy();
+            }
+            check(fast.occludes(fr, 1e-9, 2.0))
+                    == slow.occludes(sr, 1e-9, 2.0);
+        }
+    }
+
+
+    auto const sphere = suite.test("sphere", [](auto check) {
+        matches(check, animray::unit_sphere_at_origin<slow_ray>{},
+                animray::unit_sphere_at_origin<fast_ray>{});
+    });
+
+
+    auto const tri = suite.test("triangle", [](auto check) {
+        matches(check,
+                animray::triangle<slow_ray>{
+                        point(-1, -1, 0), point(1, -1, 0), point(0, 1, 0)},
+                animray::triangle<fast_ray>{
+                        vec(-1, -1, 0), vec(1, -1, 0), vec(0, 1, 0)});
+    });
+
+
+    auto const pl = suite.test("plane", [](auto check) {
+        matches(check,
+                animray::plane<slow_ray>{
+                        point(0, 0, 1), point(0, 1, 1).unit()},
+                animray::plane<fast_ray>{vec(0, 0, 1), vec(0, 1, 1).unit()});
+    });
+
+
+    auto const mov = suite.test("movable", [](auto check) {
+        animray::movable<animray::unit_sphere_at_origin<slow_ray>> slow;
+        animray::movable<animray::unit_sphere_at_origin<fast_ray>> fast;
+        slow(animray::translate<double>(0.5, 0, 0))(
+                animray::scale<double>(2, 1, 1));
+        fast(animray::translate<double>(0.5, 0, 0))(
+                animray::scale<double>(2, 1, 1));
+        matches(check, slow, fast);
+    });
+
+}